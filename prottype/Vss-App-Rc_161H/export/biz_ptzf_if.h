@@ -20,6 +20,9 @@ namespace biz_ptzf {
 static const u32_t INVALID_SEQ_ID = U32_T(0);
 static const u32_t DEFAULT_SEQ_ID = U32_T(1);
 static const u32_t TRACE_NAME_LENGTH_MAX = U32_T(32) + U32_T(1);
+static const u32_t TRACE_ID_MAX_SIZE = U32_T(16);
+static const u32_t TRACE_THUMBNAIL_FILE_PATH_LENGTH_MAX = U32_T(64);
+static const u32_t TRACE_LIST_GENERATION_INVALID = U32_T(0);
 
 enum PanTiltDirection
 {
@@ -246,6 +249,28 @@ struct TraceName
     u32_t trace_id;
 };
 
+// 呼び出し元で保持して使い回すトレース一覧
+// generationが前回取得時から変化していない場合、recordとvalid_bitmapは更新されない
+struct TraceRecordingStatusList
+{
+    TraceRecordingStatus record[TRACE_ID_MAX_SIZE];
+    u32_t valid_bitmap; // bit i が record[i].valid に対応する
+    u32_t generation;
+
+    TraceRecordingStatusList() : record(), valid_bitmap(U32_T(0)), generation(TRACE_LIST_GENERATION_INVALID)
+    {}
+};
+
+// 呼び出し元で保持して使い回すトレース名一覧
+struct TraceNameList
+{
+    TraceName name[TRACE_ID_MAX_SIZE];
+    u32_t size;
+
+    TraceNameList() : name(), size(U32_T(0))
+    {}
+};
+
 struct BizDZoomModeInquiryResult
 {
     DZoom d_zoom;
@@ -526,10 +551,14 @@ public:
     ErrorCode getPanTiltMoveStatus(bool& status);
     ErrorCode getPtzTracePrepareNumber(u32_t& trace_id);
     ErrorCode getPtzTraceStatusAllList(std::vector<TraceRecordingStatus>& record_list);
+    ErrorCode getPtzTraceStatusAllList(TraceRecordingStatusList& record_list);
     ErrorCode getPtzTraceStatusTrace(PtzTraceCondition& trace_status);
     ErrorCode getStandbyMode(StandbyMode& standby_mode);
     ErrorCode getNameList(std::vector<TraceName>& name_list);
+    ErrorCode getNameList(TraceNameList& name_list);
     ErrorCode getTraceThumbnailFilePath(const u32_t trace_id, std::string& file_path);
+    ErrorCode getTraceThumbnailFilePath(const u32_t trace_id, char_t (&file_path)[TRACE_THUMBNAIL_FILE_PATH_LENGTH_MAX]);
+    ErrorCode getTraceThumbnail(const u32_t trace_id, std::vector<u8_t>& image, u32_t& generation);
     bool getAfSubjShiftSens();
     bool getAfTransitionSpeed();
     bool getFocusFaceEyedetection();
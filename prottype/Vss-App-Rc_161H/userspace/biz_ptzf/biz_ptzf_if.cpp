@@ -7,6 +7,7 @@
 #include <vector>
 #include <string>
 #include "common_message_queue.h"
+#include "common_mutex.h"
 #include "common_log.h"
 #include "biz_ptzf_if.h"
 #include "ptzf/ptzf_common_message.h"
@@ -27,6 +28,8 @@
 #include "preset/preset_manager_message.h"
 #include "gtl_container_foreach.h"
 #include "ptzf/ptzf_parameter.h"
+#include "trace_thumbnail_store.h"
+#include "trace_thumbnail_base_dir.h"
 
 namespace biz_ptzf {
 
@@ -37,6 +40,9 @@ const char_t* TRACE_THUMBNAIL_DATA_BASE_DIR = "/usr/local/data/thumbnail/";
 const char_t* TRACE_THUMBNAIL_DATA_BASE_FILENAME = "traceimg";
 const char_t* TRACE_THUMBNAIL_DATA_BASE_FILE_EXT = ".jpg";
 
+static_assert(TRACE_ID_MAX_SIZE == ptzf::PTZ_TRACE_ID_MAX_SIZE, "TRACE_ID_MAX_SIZE mismatch");
+static_assert(TRACE_ID_MAX_SIZE <= U32_T(32), "valid_bitmap is too small");
+
 static const struct ConvertStandbyModeTable
 {
     ptzf::StandbyMode ptzf_value;
@@ -719,12 +725,183 @@ ErrorCode convertToPanTiltEnabledState(PanTiltEnabledState& biz_value, const ptz
     return ERRORCODE_VAL;
 }
 
+// BizPtzfIfの全インスタンスで共有するトレース一覧とサムネイルのキャッシュ
+// 初回の取得時に生成するため, トレース一覧を参照しないBizPtzfIfの生成ではヒープ確保を行わない
+// generationはプロセス内で一意であり, 異なるインスタンスから取得した一覧や画像同士でも比較できる
+// サムネイルの無効化も全インスタンスの次回取得に反映される
+class TraceListCache
+{
+public:
+    static TraceListCache& instance()
+    {
+        static TraceListCache cache;
+        return cache;
+    }
+
+    void getRecordList(TraceRecordingStatusList& record_list)
+    {
+        common::MutexLock lock(mutex_);
+        update();
+        if (record_list.generation != record_cache_.generation) {
+            record_list = record_cache_;
+        }
+    }
+
+    void getNameList(TraceNameList& name_list)
+    {
+        common::MutexLock lock(mutex_);
+        id_work_list_.clear();
+        ptz_trace_status_if_.getTraceNumbers(id_work_list_);
+
+        name_work_list_.clear();
+        for (u32_t i = 0; i < TRACE_ID_MAX_SIZE; ++i) {
+            if (id_work_list_[i].valid) {
+                ptz_trace_status_if_.pushNameList(id_work_list_[i].trace_id, name_work_list_);
+            }
+        }
+
+        name_list.size = U32_T(0);
+        CONTAINER_FOREACH_CONST (const TraceName& name, name_work_list_) {
+            if (name_list.size >= TRACE_ID_MAX_SIZE) {
+                break;
+            }
+            name_list.name[name_list.size] = name;
+            ++name_list.size;
+        }
+    }
+
+    void getFilePath(const u32_t trace_id, std::string& file_path)
+    {
+        common::MutexLock lock(mutex_);
+        file_path = getFilePathCache(trace_id);
+    }
+
+    ErrorCode getFilePath(const u32_t trace_id, char_t (&file_path)[TRACE_THUMBNAIL_FILE_PATH_LENGTH_MAX])
+    {
+        common::MutexLock lock(mutex_);
+        const std::string& path = getFilePathCache(trace_id);
+        if (path.size() >= TRACE_THUMBNAIL_FILE_PATH_LENGTH_MAX) {
+            return ERRORCODE_EXEC;
+        }
+        gtl::copyString(file_path, path.c_str());
+        return ERRORCODE_SUCCESS;
+    }
+
+    // ファイルの読み出し中に一覧の取得を待たせないよう, サムネイルの取得はmutex_の外で行う
+    // thumbnail_store_は自身のロックで保護する
+    ErrorCode getThumbnail(const u32_t trace_id, std::vector<u8_t>& image, u32_t& generation)
+    {
+        std::string file_path;
+        getFilePath(trace_id, file_path);
+        return thumbnail_store_.get(trace_id, file_path, image, generation);
+    }
+
+    void invalidateThumbnail(const u32_t trace_id)
+    {
+        thumbnail_store_.invalidate(trace_id);
+    }
+
+    void setBaseDir(const std::string& base_dir)
+    {
+        {
+            common::MutexLock lock(mutex_);
+            base_dir_ = base_dir.empty() ? std::string(TRACE_THUMBNAIL_DATA_BASE_DIR) : base_dir;
+            CONTAINER_FOREACH (std::string& path, file_path_cache_) {
+                path.clear();
+            }
+        }
+        thumbnail_store_.invalidateAll();
+    }
+
+private:
+    common::Mutex mutex_;
+    ptzf::PtzTraceStatusIf ptz_trace_status_if_;
+    std::vector<ptzf::PtzTraceId> id_work_list_;
+    std::vector<TraceName> name_work_list_;
+    TraceRecordingStatusList record_cache_;
+    u32_t generation_;
+    std::string base_dir_;
+    std::vector<std::string> file_path_cache_;
+    TraceThumbnailStore thumbnail_store_;
+
+    TraceListCache()
+        : mutex_(),
+          ptz_trace_status_if_(),
+          id_work_list_(),
+          name_work_list_(),
+          record_cache_(),
+          generation_(TRACE_LIST_GENERATION_INVALID),
+          base_dir_(TRACE_THUMBNAIL_DATA_BASE_DIR),
+          file_path_cache_(TRACE_ID_MAX_SIZE + U32_T(1)),
+          thumbnail_store_()
+    {
+        id_work_list_.reserve(TRACE_ID_MAX_SIZE);
+        name_work_list_.reserve(TRACE_ID_MAX_SIZE);
+    }
+
+    ~TraceListCache()
+    {}
+
+    TraceListCache(const TraceListCache&);
+    TraceListCache& operator=(const TraceListCache&);
+
+    void update()
+    {
+        id_work_list_.clear();
+        ptz_trace_status_if_.getTraceNumbers(id_work_list_);
+
+        bool changed = (generation_ == TRACE_LIST_GENERATION_INVALID);
+        u32_t valid_bitmap = U32_T(0);
+        for (u32_t i = 0; i < TRACE_ID_MAX_SIZE; ++i) {
+            TraceRecordingStatus& record = record_cache_.record[i];
+            const ptzf::PtzTraceId& id = id_work_list_[i];
+            if ((record.trace_id != id.trace_id) || (record.valid != id.valid)) {
+                record.trace_id = id.trace_id;
+                record.valid = id.valid;
+                changed = true;
+            }
+            if (id.valid) {
+                valid_bitmap |= (U32_T(1) << i);
+            }
+        }
+        if (!changed) {
+            return;
+        }
+
+        ++generation_;
+        if (generation_ == TRACE_LIST_GENERATION_INVALID) {
+            ++generation_;
+        }
+        record_cache_.valid_bitmap = valid_bitmap;
+        record_cache_.generation = generation_;
+    }
+
+    const std::string& getFilePathCache(const u32_t trace_id)
+    {
+        // トレースIDの範囲外はキャッシュせず, 末尾の作業領域に都度生成する
+        const u32_t index = (trace_id < TRACE_ID_MAX_SIZE) ? trace_id : TRACE_ID_MAX_SIZE;
+        std::string& path = file_path_cache_[index];
+        if (path.empty() || (index == TRACE_ID_MAX_SIZE)) {
+            path = gtl::StrChain()(base_dir_.c_str())(TRACE_THUMBNAIL_DATA_BASE_FILENAME)(trace_id)(
+                       TRACE_THUMBNAIL_DATA_BASE_FILE_EXT)
+                       .createString();
+        }
+        return path;
+    }
+};
+
 } // namespace
 
+void setTraceThumbnailBaseDir(const std::string& base_dir)
+{
+    TraceListCache::instance().setBaseDir(base_dir);
+}
+
 struct BizPtzfIf::BizPtzfIfImpl
 {
 public:
-    BizPtzfIfImpl() : msg_if_(event_router::EVENT_ROUTER_TARGET_TYPE_PTZF_CONTROLLER), mq_name_()
+    BizPtzfIfImpl()
+        : msg_if_(event_router::EVENT_ROUTER_TARGET_TYPE_PTZF_CONTROLLER), mq_name_()
     {}
 
     virtual ~BizPtzfIfImpl()
@@ -872,10 +1049,14 @@ public:
     ErrorCode getPanTiltMoveStatus(bool& status);
     ErrorCode getPtzTracePrepareNumber(u32_t& trace_id);
     ErrorCode getPtzTraceStatusAllList(std::vector<TraceRecordingStatus>& record_list);
+    ErrorCode getPtzTraceStatusAllList(TraceRecordingStatusList& record_list);
     ErrorCode getPtzTraceStatusTrace(PtzTraceCondition& trace_status);
     ErrorCode getStandbyMode(StandbyMode& standby_mode);
     ErrorCode getNameList(std::vector<TraceName>& name_list);
+    ErrorCode getNameList(TraceNameList& name_list);
     ErrorCode getTraceThumbnailFilePath(const u32_t trace_id, std::string& file_path);
+    ErrorCode getTraceThumbnailFilePath(const u32_t trace_id, char_t (&file_path)[TRACE_THUMBNAIL_FILE_PATH_LENGTH_MAX]);
+    ErrorCode getTraceThumbnail(const u32_t trace_id, std::vector<u8_t>& image, u32_t& generation);
     bool getAfSubjShiftSens();
     bool getAfTransitionSpeed();
     bool getFocusFaceEyedetection();
@@ -1673,6 +1854,8 @@ bool BizPtzfIf::BizPtzfIfImpl::noticeCreateTraceThumbnailComp(const std::string
     msg_if_.post(event_router::EVENT_ROUTER_TARGET_TYPE_PRESET_MANAGER, msg);
     ptzf::message::PtzfExecComp result;
     internal_reply.pend(result);
+    // サムネイルの更新完了後にキャッシュを無効化し, 次回取得時に新しいgenerationで読み直す
+    TraceListCache::instance().invalidateThumbnail(trace_id);
 
     if (!gtl::isEmpty(mq_name_.name)) {
         common::MessageQueue reply(mq_name_.name);
@@ -1691,6 +1874,8 @@ bool BizPtzfIf::BizPtzfIfImpl::noticeTraceThumbnailFileReceiveComp(const std::st
     msg_if_.post(event_router::EVENT_ROUTER_TARGET_TYPE_PRESET_MANAGER, msg);
     ptzf::message::PtzfExecComp result;
     internal_reply.pend(result);
+    // サムネイルの更新完了後にキャッシュを無効化し, 次回取得時に新しいgenerationで読み直す
+    TraceListCache::instance().invalidateThumbnail(trace_id);
 
     if (!gtl::isEmpty(mq_name_.name)) {
         common::MessageQueue reply(mq_name_.name);
@@ -1707,6 +1892,7 @@ bool BizPtzfIf::BizPtzfIfImpl::deleteTraceThumbnail(const u32_t trace_id, const
     msg_if_.post(event_router::EVENT_ROUTER_TARGET_TYPE_PRESET_MANAGER, msg);
     ptzf::message::PtzfExecComp result;
     internal_reply.pend(result);
+    TraceListCache::instance().invalidateThumbnail(trace_id);
 
     if (!gtl::isEmpty(mq_name_.name)) {
         common::MessageQueue reply(mq_name_.name);
@@ -2274,6 +2460,12 @@ ErrorCode BizPtzfIf::BizPtzfIfImpl::getPtzTraceStatusAllList(std::vector<TraceRe
     return ERRORCODE_SUCCESS;
 }
 
+ErrorCode BizPtzfIf::BizPtzfIfImpl::getPtzTraceStatusAllList(TraceRecordingStatusList& record_list)
+{
+    TraceListCache::instance().getRecordList(record_list);
+    return ERRORCODE_SUCCESS;
+}
+
 ErrorCode BizPtzfIf::BizPtzfIfImpl::getPtzTracePrepareNumber(u32_t& trace_id)
 {
     ptzf::PtzTraceStatusIf ptzf_trace_if;
@@ -2327,15 +2519,31 @@ ErrorCode BizPtzfIf::BizPtzfIfImpl::getNameList(std::vector<TraceName>& name_lis
     return ERRORCODE_SUCCESS;
 }
 
+ErrorCode BizPtzfIf::BizPtzfIfImpl::getNameList(TraceNameList& name_list)
+{
+    TraceListCache::instance().getNameList(name_list);
+    return ERRORCODE_SUCCESS;
+}
+
 ErrorCode BizPtzfIf::BizPtzfIfImpl::getTraceThumbnailFilePath(const u32_t trace_id, std::string& file_path)
 {
-    file_path = gtl::StrChain()(TRACE_THUMBNAIL_DATA_BASE_DIR)(TRACE_THUMBNAIL_DATA_BASE_FILENAME)(trace_id)(
-                    TRACE_THUMBNAIL_DATA_BASE_FILE_EXT)
-                    .createString();
+    TraceListCache::instance().getFilePath(trace_id, file_path);
 
     return ERRORCODE_SUCCESS;
 }
 
+ErrorCode
+BizPtzfIf::BizPtzfIfImpl::getTraceThumbnailFilePath(const u32_t trace_id,
+                                                    char_t (&file_path)[TRACE_THUMBNAIL_FILE_PATH_LENGTH_MAX])
+{
+    return TraceListCache::instance().getFilePath(trace_id, file_path);
+}
+
+ErrorCode BizPtzfIf::BizPtzfIfImpl::getTraceThumbnail(const u32_t trace_id, std::vector<u8_t>& image, u32_t& generation)
+{
+    return TraceListCache::instance().getThumbnail(trace_id, image, generation);
+}
+
 bool BizPtzfIf::BizPtzfIfImpl::getAfSubjShiftSens()
 {
     ptzf::PtzfBizMessageIf ptzf_biz_message_if_;
@@ -3452,6 +3660,11 @@ ErrorCode BizPtzfIf::getPtzTraceStatusAllList(std::vector<TraceRecordingStatus>&
     return pimpl_->getPtzTraceStatusAllList(record_list);
 }
 
+ErrorCode BizPtzfIf::getPtzTraceStatusAllList(TraceRecordingStatusList& record_list)
+{
+    return pimpl_->getPtzTraceStatusAllList(record_list);
+}
+
 ErrorCode BizPtzfIf::getPtzTracePrepareNumber(u32_t& trace_id)
 {
     return pimpl_->getPtzTracePrepareNumber(trace_id);
@@ -3467,11 +3680,27 @@ ErrorCode BizPtzfIf::getNameList(std::vector<TraceName>& name_list)
     return pimpl_->getNameList(name_list);
 }
 
+ErrorCode BizPtzfIf::getNameList(TraceNameList& name_list)
+{
+    return pimpl_->getNameList(name_list);
+}
+
 ErrorCode BizPtzfIf::getTraceThumbnailFilePath(const u32_t trace_id, std::string& file_path)
 {
     return pimpl_->getTraceThumbnailFilePath(trace_id, file_path);
 }
 
+ErrorCode BizPtzfIf::getTraceThumbnailFilePath(const u32_t trace_id,
+                                               char_t (&file_path)[TRACE_THUMBNAIL_FILE_PATH_LENGTH_MAX])
+{
+    return pimpl_->getTraceThumbnailFilePath(trace_id, file_path);
+}
+
+ErrorCode BizPtzfIf::getTraceThumbnail(const u32_t trace_id, std::vector<u8_t>& image, u32_t& generation)
+{
+    return pimpl_->getTraceThumbnail(trace_id, image, generation);
+}
+
 bool BizPtzfIf::getAfSubjShiftSens()
 {
     return pimpl_->getAfSubjShiftSens();
@@ -5,6 +5,9 @@
  */
 
 #include <string>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
 #include "types.h"
 #include "gtl_string.h"
 #include "gtl_memory.h"
@@ -14,6 +17,7 @@
 #include "common_gmock_util.h"
 #include "common_message_queue.h"
 #include "biz_ptzf_if.h"
+#include "../trace_thumbnail_base_dir.h"
 #include "ptzf/ptzf_message.h"
 #include "event_router/event_router_if_mock.h"
 #include "event_router/event_router_target_type.h"
@@ -25,6 +29,7 @@
 #include "visca/visca_status_if_mock.h"
 #include "ptzf/ptz_trace_status_if_mock.h"
 #include "ptzf/ptzf_common_message.h"
+#include "preset/preset_manager_message.h"
 #include "bizglobal.h"
 #include "inbound/general/model_name.h"
 
@@ -153,6 +158,16 @@ using ::testing::Invoke;
 //    + enum未定義の取得値である場合、、PtzControllerMessageHandler向けにメッセージを送信しないこと
 //    + 結果を通知するメッセージキュー名が未設定の場合、PtzControllerMessageHandler向けにメッセージを送信しないこと
 // + getStandbyMode()
+// + getPtzTraceStatusAllList(TraceRecordingStatusList&)
+//   - 全トレース登録時の一覧と有効ビットマップが取得できること
+//   - 一覧に変化がない場合はgenerationが変化しないこと
+//   - 一覧が変化した場合はgenerationが更新されること
+//   - generationはBizPtzfIfのインスタンス間で共有されること
+// + getNameList(TraceNameList&)
+// + getTraceThumbnailFilePath(u32_t, char_t (&)[])
+// + getTraceThumbnail()
+//   - 別のインスタンスで取得済みの画像は, 同じgenerationを指定した場合にコピーされないこと
+//   - 別のインスタンスでサムネイルを削除した場合, 次回取得時にファイルから読み直すこと
 // + getCamOp()
 // + getPanTiltSpeedScale()
 // + getPanTiltSpeedMode()
@@ -322,6 +337,17 @@ struct MQResponder
         ptzf::message::PtzfFocusAbsoluteAck result(DEFAULT_SEQ_ID, false);
         mq.post(result);
     }
+    void returnDeleteTraceThumbnailComp(const event_router::EventRouterTargetType,
+                                        const u32_t,
+                                        const u32_t,
+                                        const char_t* arg_msg)
+    {
+        preset::BizMessage<preset::DeleteTraceThumbnailDataRequest>* msg =
+            (preset::BizMessage<preset::DeleteTraceThumbnailDataRequest>*)arg_msg;
+        common::MessageQueue mq(msg->mq_name.name);
+        ptzf::message::PtzfExecComp result(msg->seq_id, ERRORCODE_SUCCESS);
+        mq.post(result);
+    }
 };
 
 const struct PanTiltMoveTestValueTable
@@ -4871,6 +4897,194 @@ TEST_F(BizPtzfIfTest, getName)
     EXPECT_EQ(ERRORCODE_SUCCESS, err);
 }
 
+TEST_F(BizPtzfIfTest, getPtzTraceStatusAllListFixedCapacity)
+{
+    BizPtzfIf biz_ptzf_if;
+
+    std::vector<ptzf::PtzTraceId> id_list;
+    for (u32_t i = 0; i < ptzf::PTZ_TRACE_ID_MAX_SIZE; ++i) {
+        ptzf::PtzTraceId id(i, true);
+        id_list.push_back(id);
+    }
+    EXPECT_CALL(ptz_trace_status_if_mock_, getTraceNumbers(_))
+        .WillRepeatedly(DoAll(SetArgReferee<0>(id_list), Return()));
+
+    TraceRecordingStatusList record_list;
+    EXPECT_EQ(ERRORCODE_SUCCESS, biz_ptzf_if.getPtzTraceStatusAllList(record_list));
+    EXPECT_NE(TRACE_LIST_GENERATION_INVALID, record_list.generation);
+    EXPECT_EQ(U32_T(0xFFFF), record_list.valid_bitmap);
+    for (u32_t i = 0; i < TRACE_ID_MAX_SIZE; ++i) {
+        EXPECT_EQ(i, record_list.record[i].trace_id);
+        EXPECT_TRUE(record_list.record[i].valid);
+    }
+
+    // 全トレース登録状態で一覧取得を繰り返しても, 一覧が変化しなければgenerationは変わらない
+    const u32_t generation = record_list.generation;
+    for (u32_t count = 0; count < U32_T(1000); ++count) {
+        EXPECT_EQ(ERRORCODE_SUCCESS, biz_ptzf_if.getPtzTraceStatusAllList(record_list));
+    }
+    EXPECT_EQ(generation, record_list.generation);
+
+    id_list[3].valid = false;
+    EXPECT_CALL(ptz_trace_status_if_mock_, getTraceNumbers(_))
+        .WillRepeatedly(DoAll(SetArgReferee<0>(id_list), Return()));
+    EXPECT_EQ(ERRORCODE_SUCCESS, biz_ptzf_if.getPtzTraceStatusAllList(record_list));
+    EXPECT_NE(generation, record_list.generation);
+    EXPECT_EQ(U32_T(0xFFF7), record_list.valid_bitmap);
+    EXPECT_FALSE(record_list.record[3].valid);
+}
+
+TEST_F(BizPtzfIfTest, getPtzTraceStatusAllListSharedGeneration)
+{
+    std::vector<ptzf::PtzTraceId> id_list;
+    for (u32_t i = 0; i < ptzf::PTZ_TRACE_ID_MAX_SIZE; ++i) {
+        ptzf::PtzTraceId id(i, (i % U32_T(3)) == U32_T(0));
+        id_list.push_back(id);
+    }
+    EXPECT_CALL(ptz_trace_status_if_mock_, getTraceNumbers(_))
+        .WillRepeatedly(DoAll(SetArgReferee<0>(id_list), Return()));
+
+    TraceRecordingStatusList record_list;
+    {
+        BizPtzfIf biz_ptzf_if;
+        EXPECT_EQ(ERRORCODE_SUCCESS, biz_ptzf_if.getPtzTraceStatusAllList(record_list));
+    }
+    const u32_t generation = record_list.generation;
+    EXPECT_NE(TRACE_LIST_GENERATION_INVALID, generation);
+
+    // 別のインスタンスから取得しても, 一覧が変化していなければ同じgenerationとなる
+    BizPtzfIf other_biz_ptzf_if;
+    TraceRecordingStatusList other_record_list;
+    EXPECT_EQ(ERRORCODE_SUCCESS, other_biz_ptzf_if.getPtzTraceStatusAllList(other_record_list));
+    EXPECT_EQ(generation, other_record_list.generation);
+    EXPECT_EQ(record_list.valid_bitmap, other_record_list.valid_bitmap);
+
+    // 一覧の変化を別のインスタンスで検出した場合も, 新しいgenerationは重複しない
+    id_list[1].valid = true;
+    EXPECT_CALL(ptz_trace_status_if_mock_, getTraceNumbers(_))
+        .WillRepeatedly(DoAll(SetArgReferee<0>(id_list), Return()));
+    BizPtzfIf new_biz_ptzf_if;
+    EXPECT_EQ(ERRORCODE_SUCCESS, new_biz_ptzf_if.getPtzTraceStatusAllList(record_list));
+    EXPECT_NE(generation, record_list.generation);
+    EXPECT_TRUE(record_list.record[1].valid);
+    EXPECT_EQ(ERRORCODE_SUCCESS, other_biz_ptzf_if.getPtzTraceStatusAllList(other_record_list));
+    EXPECT_EQ(record_list.generation, other_record_list.generation);
+    EXPECT_TRUE(other_record_list.record[1].valid);
+}
+
+TEST_F(BizPtzfIfTest, getNameListFixedCapacity)
+{
+    BizPtzfIf biz_ptzf_if;
+
+    std::vector<ptzf::PtzTraceId> id_list;
+    for (u32_t i = 0; i < ptzf::PTZ_TRACE_ID_MAX_SIZE; ++i) {
+        ptzf::PtzTraceId id(i, (i % U32_T(2)) == U32_T(0));
+        id_list.push_back(id);
+    }
+    EXPECT_CALL(ptz_trace_status_if_mock_, getTraceNumbers(_))
+        .WillRepeatedly(DoAll(SetArgReferee<0>(id_list), Return()));
+    EXPECT_CALL(ptz_trace_status_if_mock_, pushNameList(_, _))
+        .Times(8)
+        .WillRepeatedly(Invoke([](const u32_t trace_id, std::vector<TraceName>& name_list) {
+            TraceName name = {};
+            name.trace_id = trace_id;
+            name_list.push_back(name);
+        }));
+
+    TraceNameList name_list;
+    EXPECT_EQ(ERRORCODE_SUCCESS, biz_ptzf_if.getNameList(name_list));
+    EXPECT_EQ(U32_T(8), name_list.size);
+    for (u32_t i = 0; i < name_list.size; ++i) {
+        EXPECT_EQ(i * U32_T(2), name_list.name[i].trace_id);
+    }
+}
+
+TEST_F(BizPtzfIfTest, getTraceThumbnailFilePathFixedBuffer)
+{
+    BizPtzfIf biz_ptzf_if;
+
+    for (u32_t i = 0; i < TRACE_ID_MAX_SIZE + U32_T(1); ++i) {
+        std::string expected;
+        EXPECT_EQ(ERRORCODE_SUCCESS, biz_ptzf_if.getTraceThumbnailFilePath(i, expected));
+
+        char_t file_path[TRACE_THUMBNAIL_FILE_PATH_LENGTH_MAX] = {};
+        EXPECT_EQ(ERRORCODE_SUCCESS, biz_ptzf_if.getTraceThumbnailFilePath(i, file_path));
+        EXPECT_STREQ(expected.c_str(), file_path);
+    }
+}
+
+// サムネイルの配置先を一時ディレクトリに変更し, 製品の配置先にファイルを作成しない
+class BizPtzfIfTraceThumbnailTest : public BizPtzfIfTest
+{
+protected:
+    BizPtzfIfTraceThumbnailTest() : dir_()
+    {}
+
+    virtual void SetUp()
+    {
+        BizPtzfIfTest::SetUp();
+        char_t templ[] = "/tmp/biz_ptzf_if_test.XXXXXX";
+        ASSERT_TRUE(mkdtemp(templ) != nullptr);
+        dir_ = templ;
+        setTraceThumbnailBaseDir(dir_ + "/");
+    }
+
+    virtual void TearDown()
+    {
+        BizPtzfIf biz_ptzf_if;
+        for (u32_t i = 0; i < TRACE_ID_MAX_SIZE; ++i) {
+            std::string file_path;
+            biz_ptzf_if.getTraceThumbnailFilePath(i, file_path);
+            unlink(file_path.c_str());
+        }
+        rmdir(dir_.c_str());
+        setTraceThumbnailBaseDir("");
+        BizPtzfIfTest::TearDown();
+    }
+
+    std::string dir_;
+};
+
+TEST_F(BizPtzfIfTraceThumbnailTest, getTraceThumbnailSharedAcrossInstances)
+{
+    // getTraceThumbnailFilePath()が返す実パスにサムネイルを配置する
+    const u32_t trace_id = TRACE_ID_MAX_SIZE - U32_T(1);
+
+    BizPtzfIf biz_ptzf_if;
+    std::string file_path;
+    EXPECT_EQ(ERRORCODE_SUCCESS, biz_ptzf_if.getTraceThumbnailFilePath(trace_id, file_path));
+    EXPECT_EQ(0U, file_path.find(dir_ + "/"));
+    const std::vector<u8_t> data(U32_T(100), U8_T(0xAB));
+    FILE* fp = fopen(file_path.c_str(), "wb");
+    ASSERT_TRUE(fp != nullptr);
+    ASSERT_EQ(data.size(), fwrite(&data[0], 1, data.size(), fp));
+    fclose(fp);
+
+    std::vector<u8_t> image;
+    u32_t generation = U32_T(0);
+    EXPECT_EQ(ERRORCODE_SUCCESS, biz_ptzf_if.getTraceThumbnail(trace_id, image, generation));
+    EXPECT_EQ(data, image);
+    const u32_t first_generation = generation;
+    EXPECT_NE(U32_T(0), first_generation);
+
+    BizPtzfIf other_biz_ptzf_if;
+    std::vector<u8_t> other_image;
+    EXPECT_EQ(ERRORCODE_SUCCESS, other_biz_ptzf_if.getTraceThumbnail(trace_id, other_image, generation));
+    EXPECT_TRUE(other_image.empty());
+    EXPECT_EQ(first_generation, generation);
+
+    // 別のインスタンスでの削除完了時の無効化が反映され, ファイルから読み直して新しいgenerationとなる
+    MQResponder responder;
+    EXPECT_CALL(er_mock_, post(event_router::EVENT_ROUTER_TARGET_TYPE_PRESET_MANAGER, _, _, _))
+        .Times(1)
+        .WillOnce(DoAll(Invoke(&responder, &MQResponder::returnDeleteTraceThumbnailComp), Return()));
+    EXPECT_TRUE(other_biz_ptzf_if.deleteTraceThumbnail(trace_id));
+
+    EXPECT_EQ(ERRORCODE_SUCCESS, biz_ptzf_if.getTraceThumbnail(trace_id, image, generation));
+    EXPECT_NE(first_generation, generation);
+    EXPECT_EQ(data, image);
+}
+
 TEST_F(BizPtzfIfTest, setAfSubjShiftSens)
 {
     EXPECT_CALL(er_mock_, create(event_router::EVENT_ROUTER_TARGET_TYPE_PTZF_CONTROLLER)).Times(1).WillOnce(Return());
@@ -0,0 +1,227 @@
+/*
+ * trace_thumbnail_store_test.cpp
+ *
+ * Copyright 2026 Sony Corporation
+ */
+
+#include "types.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+
+#include "trace_thumbnail_store.h"
+
+namespace biz_ptzf {
+
+// ○テストリスト
+// + 初回取得時はファイルから読み出し, 画像とgenerationを返すこと
+// + 同一generationを指定した場合は画像をコピーしないこと
+// + ファイルが更新された場合は読み直してgenerationを更新すること
+// + invalidate()後の取得ではファイルから読み直すこと
+// + ファイルが存在しない場合はエラーを返すこと
+// + CACHE_ENTRY_MAXはトレース数の上限(TRACE_ID_MAX_SIZE)と一致すること
+// + 全トレースのサムネイル取得を繰り返しても, ファイル読み出しはトレース数分のみであること
+// + キャッシュが満杯の場合は最も古く参照されたサムネイルを破棄すること
+// + 異なるトレースのサムネイルに同じgenerationを付与しないこと
+
+class TraceThumbnailStoreTest : public ::testing::Test
+{
+protected:
+    TraceThumbnailStoreTest() : dir_()
+    {}
+
+    virtual void SetUp()
+    {
+        char_t templ[] = "/tmp/trace_thumbnail_store_test.XXXXXX";
+        ASSERT_TRUE(mkdtemp(templ) != nullptr);
+        dir_ = templ;
+    }
+
+    virtual void TearDown()
+    {
+        for (u32_t i = 0; i <= TraceThumbnailStore::CACHE_ENTRY_MAX; ++i) {
+            unlink(getPath(i).c_str());
+        }
+        rmdir(dir_.c_str());
+    }
+
+    std::string getPath(const u32_t trace_id) const
+    {
+        char_t name[32];
+        sprintf(name, "/traceimg%u.jpg", trace_id);
+        return dir_ + name;
+    }
+
+    void writeFile(const u32_t trace_id, const std::vector<u8_t>& data) const
+    {
+        // 更新時刻が変化しなくてもサイズ差で検出できるよう, 一時ファイル経由で置き換える
+        const std::string tmp_path = getPath(trace_id) + ".tmp";
+        FILE* fp = fopen(tmp_path.c_str(), "wb");
+        ASSERT_TRUE(fp != nullptr);
+        if (!data.empty()) {
+            ASSERT_EQ(data.size(), fwrite(&data[0], 1, data.size(), fp));
+        }
+        fclose(fp);
+        ASSERT_EQ(0, rename(tmp_path.c_str(), getPath(trace_id).c_str()));
+    }
+
+    std::string dir_;
+};
+
+TEST_F(TraceThumbnailStoreTest, LoadFromFile)
+{
+    const std::vector<u8_t> data(U32_T(100), U8_T(0xAB));
+    writeFile(U32_T(1), data);
+
+    TraceThumbnailStore store;
+    std::vector<u8_t> image;
+    u32_t generation = TraceThumbnailStore::GENERATION_INVALID;
+    EXPECT_EQ(ERRORCODE_SUCCESS, store.get(U32_T(1), getPath(U32_T(1)), image, generation));
+    EXPECT_EQ(data, image);
+    EXPECT_NE(TraceThumbnailStore::GENERATION_INVALID, generation);
+    EXPECT_EQ(U32_T(1), store.getFileReadCount());
+}
+
+TEST_F(TraceThumbnailStoreTest, SameGenerationSkipsCopy)
+{
+    writeFile(U32_T(1), std::vector<u8_t>(U32_T(100), U8_T(0xAB)));
+
+    TraceThumbnailStore store;
+    std::vector<u8_t> image;
+    u32_t generation = TraceThumbnailStore::GENERATION_INVALID;
+    EXPECT_EQ(ERRORCODE_SUCCESS, store.get(U32_T(1), getPath(U32_T(1)), image, generation));
+    const u32_t first_generation = generation;
+
+    image.clear();
+    EXPECT_EQ(ERRORCODE_SUCCESS, store.get(U32_T(1), getPath(U32_T(1)), image, generation));
+    EXPECT_TRUE(image.empty());
+    EXPECT_EQ(first_generation, generation);
+    EXPECT_EQ(U32_T(1), store.getFileReadCount());
+}
+
+TEST_F(TraceThumbnailStoreTest, ReloadWhenFileChanged)
+{
+    writeFile(U32_T(1), std::vector<u8_t>(U32_T(100), U8_T(0xAB)));
+
+    TraceThumbnailStore store;
+    std::vector<u8_t> image;
+    u32_t generation = TraceThumbnailStore::GENERATION_INVALID;
+    EXPECT_EQ(ERRORCODE_SUCCESS, store.get(U32_T(1), getPath(U32_T(1)), image, generation));
+    const u32_t first_generation = generation;
+
+    const std::vector<u8_t> data(U32_T(200), U8_T(0xCD));
+    writeFile(U32_T(1), data);
+    EXPECT_EQ(ERRORCODE_SUCCESS, store.get(U32_T(1), getPath(U32_T(1)), image, generation));
+    EXPECT_EQ(data, image);
+    EXPECT_NE(first_generation, generation);
+    EXPECT_EQ(U32_T(2), store.getFileReadCount());
+}
+
+TEST_F(TraceThumbnailStoreTest, ReloadAfterInvalidate)
+{
+    writeFile(U32_T(1), std::vector<u8_t>(U32_T(100), U8_T(0xAB)));
+
+    TraceThumbnailStore store;
+    std::vector<u8_t> image;
+    u32_t generation = TraceThumbnailStore::GENERATION_INVALID;
+    EXPECT_EQ(ERRORCODE_SUCCESS, store.get(U32_T(1), getPath(U32_T(1)), image, generation));
+    const u32_t first_generation = generation;
+
+    store.invalidate(U32_T(1));
+    EXPECT_EQ(ERRORCODE_SUCCESS, store.get(U32_T(1), getPath(U32_T(1)), image, generation));
+    EXPECT_NE(first_generation, generation);
+    EXPECT_EQ(U32_T(2), store.getFileReadCount());
+}
+
+TEST_F(TraceThumbnailStoreTest, FileNotFound)
+{
+    TraceThumbnailStore store;
+    std::vector<u8_t> image;
+    u32_t generation = TraceThumbnailStore::GENERATION_INVALID;
+    EXPECT_EQ(ERRORCODE_EXEC, store.get(U32_T(1), getPath(U32_T(1)), image, generation));
+    EXPECT_EQ(TraceThumbnailStore::GENERATION_INVALID, generation);
+}
+
+TEST_F(TraceThumbnailStoreTest, CacheHoldsAllTraces)
+{
+    EXPECT_EQ(TRACE_ID_MAX_SIZE, TraceThumbnailStore::CACHE_ENTRY_MAX);
+}
+
+TEST_F(TraceThumbnailStoreTest, RepeatedListReadsEachFileOnce)
+{
+    for (u32_t i = 0; i < TRACE_ID_MAX_SIZE; ++i) {
+        writeFile(i, std::vector<u8_t>(U32_T(1024) + i, static_cast<u8_t>(i)));
+    }
+
+    // 一覧表示と同様に全トレースのサムネイルを順に2周取得する
+    // 保持件数がトレース数より少ないと, LRUでは2周目も全件の読み出しとなる
+    TraceThumbnailStore store;
+    std::vector<u8_t> image[TRACE_ID_MAX_SIZE];
+    u32_t generation[TRACE_ID_MAX_SIZE] = {};
+    for (u32_t i = 0; i < TRACE_ID_MAX_SIZE; ++i) {
+        EXPECT_EQ(ERRORCODE_SUCCESS, store.get(i, getPath(i), image[i], generation[i]));
+    }
+    EXPECT_EQ(TRACE_ID_MAX_SIZE, store.getFileReadCount());
+
+    for (u32_t i = 0; i < TRACE_ID_MAX_SIZE; ++i) {
+        const u32_t first_generation = generation[i];
+        image[i].clear();
+        EXPECT_EQ(ERRORCODE_SUCCESS, store.get(i, getPath(i), image[i], generation[i]));
+        EXPECT_EQ(first_generation, generation[i]);
+        EXPECT_TRUE(image[i].empty());
+    }
+    EXPECT_EQ(TRACE_ID_MAX_SIZE, store.getFileReadCount());
+}
+
+TEST_F(TraceThumbnailStoreTest, EvictLeastRecentlyUsed)
+{
+    for (u32_t i = 0; i <= TraceThumbnailStore::CACHE_ENTRY_MAX; ++i) {
+        writeFile(i, std::vector<u8_t>(U32_T(16), static_cast<u8_t>(i)));
+    }
+
+    TraceThumbnailStore store;
+    std::vector<u8_t> image;
+    for (u32_t i = 0; i < TraceThumbnailStore::CACHE_ENTRY_MAX; ++i) {
+        u32_t generation = TraceThumbnailStore::GENERATION_INVALID;
+        EXPECT_EQ(ERRORCODE_SUCCESS, store.get(i, getPath(i), image, generation));
+    }
+    // trace_id 0を参照し直し, trace_id 1を最も古く参照されたサムネイルにする
+    u32_t generation = TraceThumbnailStore::GENERATION_INVALID;
+    EXPECT_EQ(ERRORCODE_SUCCESS, store.get(U32_T(0), getPath(U32_T(0)), image, generation));
+    EXPECT_EQ(TraceThumbnailStore::CACHE_ENTRY_MAX, store.getFileReadCount());
+
+    const u32_t added_id = TraceThumbnailStore::CACHE_ENTRY_MAX;
+    generation = TraceThumbnailStore::GENERATION_INVALID;
+    EXPECT_EQ(ERRORCODE_SUCCESS, store.get(added_id, getPath(added_id), image, generation));
+    EXPECT_EQ(TraceThumbnailStore::CACHE_ENTRY_MAX + U32_T(1), store.getFileReadCount());
+
+    generation = TraceThumbnailStore::GENERATION_INVALID;
+    EXPECT_EQ(ERRORCODE_SUCCESS, store.get(U32_T(0), getPath(U32_T(0)), image, generation));
+    EXPECT_EQ(TraceThumbnailStore::CACHE_ENTRY_MAX + U32_T(1), store.getFileReadCount());
+
+    generation = TraceThumbnailStore::GENERATION_INVALID;
+    EXPECT_EQ(ERRORCODE_SUCCESS, store.get(U32_T(1), getPath(U32_T(1)), image, generation));
+    EXPECT_EQ(TraceThumbnailStore::CACHE_ENTRY_MAX + U32_T(2), store.getFileReadCount());
+}
+
+TEST_F(TraceThumbnailStoreTest, GenerationIsUniqueAcrossTraces)
+{
+    writeFile(U32_T(1), std::vector<u8_t>(U32_T(16), U8_T(0x01)));
+    writeFile(U32_T(2), std::vector<u8_t>(U32_T(16), U8_T(0x02)));
+
+    TraceThumbnailStore store;
+    std::vector<u8_t> image;
+    u32_t generation = TraceThumbnailStore::GENERATION_INVALID;
+    EXPECT_EQ(ERRORCODE_SUCCESS, store.get(U32_T(1), getPath(U32_T(1)), image, generation));
+
+    // trace_id 1のgenerationを指定してtrace_id 2を取得しても, 画像がコピーされること
+    EXPECT_EQ(ERRORCODE_SUCCESS, store.get(U32_T(2), getPath(U32_T(2)), image, generation));
+    EXPECT_EQ(std::vector<u8_t>(U32_T(16), U8_T(0x02)), image);
+}
+
+} // namespace biz_ptzf
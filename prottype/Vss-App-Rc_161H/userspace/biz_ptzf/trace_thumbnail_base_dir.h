@@ -0,0 +1,21 @@
+/*
+ * trace_thumbnail_base_dir.h
+ *
+ * Copyright 2026 Sony Corporation
+ */
+
+#ifndef BIZ_PTZF_TRACE_THUMBNAIL_BASE_DIR_H_
+#define BIZ_PTZF_TRACE_THUMBNAIL_BASE_DIR_H_
+
+#include <string>
+
+namespace biz_ptzf {
+
+// BizPtzfIfが返すトレースサムネイル画像の配置先ディレクトリ(末尾の'/'を含む)を変更する
+// 試験で製品の配置先にファイルを作成しないために使用する. 空文字列を指定した場合は既定の配置先に戻す
+// 全インスタンスで共有するファイルパスとサムネイル画像のキャッシュは破棄する
+void setTraceThumbnailBaseDir(const std::string& base_dir);
+
+} // namespace biz_ptzf
+
+#endif // BIZ_PTZF_TRACE_THUMBNAIL_BASE_DIR_H_
@@ -0,0 +1,165 @@
+/*
+ * trace_thumbnail_store.cpp
+ *
+ * Copyright 2026 Sony Corporation
+ */
+
+#include "types.h"
+
+#include <stdio.h>
+#include <sys/stat.h>
+
+#include "trace_thumbnail_store.h"
+
+namespace biz_ptzf {
+
+namespace {
+
+bool isSameTime(const struct timespec& lhs, const struct timespec& rhs)
+{
+    return (lhs.tv_sec == rhs.tv_sec) && (lhs.tv_nsec == rhs.tv_nsec);
+}
+
+} // namespace
+
+const u32_t TraceThumbnailStore::CACHE_ENTRY_MAX;
+const u32_t TraceThumbnailStore::GENERATION_INVALID;
+
+TraceThumbnailStore::TraceThumbnailStore()
+    : mutex_(),
+      entries_(),
+      generation_(GENERATION_INVALID),
+      use_count_(U32_T(0)),
+      file_read_count_(U32_T(0)),
+      invalidate_count_(U32_T(0))
+{}
+
+TraceThumbnailStore::~TraceThumbnailStore()
+{}
+
+ErrorCode TraceThumbnailStore::get(const u32_t trace_id,
+                                   const std::string& file_path,
+                                   std::vector<u8_t>& image,
+                                   u32_t& generation)
+{
+    struct stat st;
+    if (stat(file_path.c_str(), &st) != 0) {
+        invalidate(trace_id);
+        return ERRORCODE_EXEC;
+    }
+
+    u32_t invalidate_count = U32_T(0);
+    {
+        common::MutexLock lock(mutex_);
+        Entry* entry = find(trace_id);
+        if (entry != nullptr && isSameTime(entry->mtime, st.st_mtim) && entry->size == st.st_size) {
+            use(*entry, image, generation);
+            return ERRORCODE_SUCCESS;
+        }
+        invalidate_count = invalidate_count_;
+    }
+
+    std::vector<u8_t> loaded_image;
+    if (!load(file_path, st.st_size, loaded_image)) {
+        invalidate(trace_id);
+        return ERRORCODE_EXEC;
+    }
+
+    common::MutexLock lock(mutex_);
+    ++file_read_count_;
+    if (invalidate_count != invalidate_count_) {
+        // 読み出し中に無効化されたため, 読み出した画像は返すがキャッシュしない
+        image.swap(loaded_image);
+        generation = nextGeneration();
+        return ERRORCODE_SUCCESS;
+    }
+
+    Entry* entry = find(trace_id);
+    Entry& target = (entry == nullptr) ? selectVictim() : *entry;
+    target.valid = true;
+    target.trace_id = trace_id;
+    target.generation = nextGeneration();
+    target.mtime = st.st_mtim;
+    target.size = st.st_size;
+    target.image.swap(loaded_image);
+    use(target, image, generation);
+    return ERRORCODE_SUCCESS;
+}
+
+void TraceThumbnailStore::invalidate(const u32_t trace_id)
+{
+    common::MutexLock lock(mutex_);
+    ++invalidate_count_;
+    Entry* entry = find(trace_id);
+    if (entry != nullptr) {
+        entry->valid = false;
+    }
+}
+
+void TraceThumbnailStore::invalidateAll()
+{
+    common::MutexLock lock(mutex_);
+    ++invalidate_count_;
+    for (u32_t i = 0; i < CACHE_ENTRY_MAX; ++i) {
+        entries_[i].valid = false;
+    }
+}
+
+void TraceThumbnailStore::use(Entry& entry, std::vector<u8_t>& image, u32_t& generation)
+{
+    ++use_count_;
+    entry.last_used = use_count_;
+    if (generation != entry.generation) {
+        image = entry.image;
+        generation = entry.generation;
+    }
+}
+
+TraceThumbnailStore::Entry* TraceThumbnailStore::find(const u32_t trace_id)
+{
+    for (u32_t i = 0; i < CACHE_ENTRY_MAX; ++i) {
+        if (entries_[i].valid && entries_[i].trace_id == trace_id) {
+            return &entries_[i];
+        }
+    }
+    return nullptr;
+}
+
+TraceThumbnailStore::Entry& TraceThumbnailStore::selectVictim()
+{
+    Entry* victim = &entries_[0];
+    for (u32_t i = 0; i < CACHE_ENTRY_MAX; ++i) {
+        if (!entries_[i].valid) {
+            return entries_[i];
+        }
+        if (entries_[i].last_used < victim->last_used) {
+            victim = &entries_[i];
+        }
+    }
+    return *victim;
+}
+
+// ロック外で呼び出すため, キャッシュのエントリには触れず読み込み先のimageのみ更新する
+bool TraceThumbnailStore::load(const std::string& file_path, const off_t size, std::vector<u8_t>& image)
+{
+    FILE* fp = fopen(file_path.c_str(), "rb");
+    if (fp == nullptr) {
+        return false;
+    }
+
+    image.resize(static_cast<size_t>(size));
+    const size_t read_size = (size > 0) ? fread(&image[0], 1, image.size(), fp) : 0;
+    fclose(fp);
+    return read_size == image.size();
+}
+
+u32_t TraceThumbnailStore::nextGeneration()
+{
+    ++generation_;
+    if (generation_ == GENERATION_INVALID) {
+        ++generation_;
+    }
+    return generation_;
+}
+
+} // namespace biz_ptzf
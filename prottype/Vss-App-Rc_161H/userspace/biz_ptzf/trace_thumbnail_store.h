@@ -0,0 +1,87 @@
+/*
+ * trace_thumbnail_store.h
+ *
+ * Copyright 2026 Sony Corporation
+ */
+
+#ifndef BIZ_PTZF_TRACE_THUMBNAIL_STORE_H_
+#define BIZ_PTZF_TRACE_THUMBNAIL_STORE_H_
+
+#include <string>
+#include <vector>
+#include <time.h>
+#include <sys/types.h>
+
+#include "types.h"
+#include "errorcode.h"
+#include "common_mutex.h"
+#include "biz_ptzf_if.h"
+
+namespace biz_ptzf {
+
+// トレースサムネイル画像のキャッシュ
+// 登録可能なトレース数(TRACE_ID_MAX_SIZE)分の画像を保持し, ファイルの更新時刻とサイズが変化していなければファイルを読み直さない
+// 範囲外のトレースIDが混在して満杯となった場合は, 最も古く参照された画像を破棄する
+// 読み出した画像にはストア内で一意なgenerationを付与し, 呼び出し元が保持している画像から変化がなければ画像のコピーを省略する
+// 複数スレッドから呼び出し可能. ファイルの確認・読み出しはロック外で行い, キャッシュの参照・更新のみロックする
+class TraceThumbnailStore
+{
+public:
+    static const u32_t CACHE_ENTRY_MAX = TRACE_ID_MAX_SIZE;
+    static const u32_t GENERATION_INVALID = U32_T(0);
+
+    TraceThumbnailStore();
+    ~TraceThumbnailStore();
+
+    // generationが現在のキャッシュと一致する場合はimageを更新しない
+    ErrorCode get(const u32_t trace_id, const std::string& file_path, std::vector<u8_t>& image, u32_t& generation);
+    // サムネイルの作成・削除完了時に呼び出し, 次回取得時にファイルから読み直させる
+    void invalidate(const u32_t trace_id);
+    // 全てのサムネイルを次回取得時にファイルから読み直させる
+    void invalidateAll();
+
+    u32_t getFileReadCount()
+    {
+        common::MutexLock lock(mutex_);
+        return file_read_count_;
+    }
+
+private:
+    struct Entry
+    {
+        bool valid;
+        u32_t trace_id;
+        u32_t generation;
+        u32_t last_used;
+        struct timespec mtime;
+        off_t size;
+        std::vector<u8_t> image;
+
+        Entry()
+            : valid(false),
+              trace_id(U32_T(0)),
+              generation(GENERATION_INVALID),
+              last_used(U32_T(0)),
+              mtime(),
+              size(0),
+              image()
+        {}
+    };
+
+    common::Mutex mutex_;
+    Entry entries_[CACHE_ENTRY_MAX];
+    u32_t generation_;
+    u32_t use_count_;
+    u32_t file_read_count_;
+    u32_t invalidate_count_;
+
+    Entry* find(const u32_t trace_id);
+    Entry& selectVictim();
+    bool load(const std::string& file_path, const off_t size, std::vector<u8_t>& image);
+    void use(Entry& entry, std::vector<u8_t>& image, u32_t& generation);
+    u32_t nextGeneration();
+};
+
+} // namespace biz_ptzf
+
+#endif // BIZ_PTZF_TRACE_THUMBNAIL_STORE_H_
@@ -91,6 +91,8 @@ public:
     s32_t roundPTZTiltRelativeMoveRange(const s32_t sin_tilt_move_position) const;
     bool isValidSinPanRelativeMoveRange(const s32_t sin_pan_move_position) const;
     bool isValidSinTiltRelativeMoveRange(const s32_t sin_tilt_move_position) const;
+    bool isValidSinPanRelativeMoveRange(const s32_t sin_pan_move_position, const u32_t current_pan) const;
+    bool isValidSinTiltRelativeMoveRange(const s32_t sin_tilt_move_position, const u32_t current_tilt) const;
 
     bool getPanLimitMode() const;
     bool getTiltLimitMode() const;
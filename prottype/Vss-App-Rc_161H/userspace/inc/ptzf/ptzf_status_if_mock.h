@@ -73,6 +73,11 @@ public:
     MOCK_CONST_METHOD1(getZoomMaxVelocity, bool(u8_t& velocity));
     MOCK_CONST_METHOD1(roundPTZPanRelativeMoveRange, s32_t(const s32_t sin_pan_move_position));
     MOCK_CONST_METHOD1(roundPTZTiltRelativeMoveRange, s32_t(const s32_t sin_tilt_move_position));
+    MOCK_CONST_METHOD1(isValidSinPanRelativeMoveRange, bool(const s32_t sin_pan_move_position));
+    MOCK_CONST_METHOD1(isValidSinTiltRelativeMoveRange, bool(const s32_t sin_tilt_move_position));
+    MOCK_CONST_METHOD2(isValidSinPanRelativeMoveRange, bool(const s32_t sin_pan_move_position, const u32_t current_pan));
+    MOCK_CONST_METHOD2(isValidSinTiltRelativeMoveRange,
+                       bool(const s32_t sin_tilt_move_position, const u32_t current_tilt));
     MOCK_CONST_METHOD0(getPanLimitMode, bool());
     MOCK_CONST_METHOD0(getTiltLimitMode, bool());
     MOCK_CONST_METHOD1(isValidPanSpeed, bool(const u8_t pan_speed));
@@ -5,6 +5,7 @@
  */
 
 #include <deque>
+#include <time.h>
 
 #include "types.h"
 
@@ -63,6 +64,16 @@ const common::Log::PrintFunc& pf(common::Log::instance().getPrintFunc());
 
 const u8_t PAN_TILT_SPEED_NA = U8_T(0);
 
+// PT Lock/Unlock遷移処理の完了期限
+const u32_t PAN_TILT_LOCK_TRANSITION_TIMEOUT_MSEC = U32_T(30000);
+
+u32_t getMonotonicTimeMsec()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<u32_t>((ts.tv_sec * 1000) + (ts.tv_nsec / 1000000));
+}
+
 template <class T>
 void returnResult(const T& result, const common::MessageQueueName& reply_name)
 {
@@ -239,6 +250,7 @@ PtzfControllerMessageHandler::PtzfControllerMessageHandler()
       ptz_trace_thread_mq_(PtzTraceControllerThreadMQ::getName()),
       ptz_trace_controller_(recv_, ptz_trace_thread_mq_),
       status_infra_if_(),
+      ptzf_status_if_(),
       config_if_(),
       pan_tilt_infra_if_(),
       zoom_infra_if_(),
@@ -252,7 +264,17 @@ PtzfControllerMessageHandler::PtzfControllerMessageHandler()
       initializing_seq_id_(INVALID_SEQ_ID),
       finalizing_seq_id_(INVALID_SEQ_ID),
       seq_controller_(),
-      pt_transition_executing_(false)
+      pt_transition_executing_(false),
+      live_position_(),
+      power_sequence_cache_(),
+      pt_lock_reply_mq_(),
+      pt_lock_operation_queue_(),
+      pt_lock_continuation_(nullptr),
+      pt_lock_transition_id_(U32_T(0)),
+      pt_lock_operation_in_flight_(false),
+      pt_lock_requested_status_(),
+      pt_lock_transition_start_msec_(U32_T(0)),
+      pt_lock_timer_()
 {
     common::Log::printBootTimeTagBegin("PtzfCtrl init");
 
@@ -281,6 +303,11 @@ PtzfControllerMessageHandler::PtzfControllerMessageHandler()
     mq_.setHandler(this, &PtzfControllerMessageHandler::handleRequest<FinalizePanTiltResult>);
     select_.addReadHandler(mq_.getFD(), &mq_, &common::MessageQueue::pend);
 
+    pt_lock_reply_mq_.setHandler(this, &PtzfControllerMessageHandler::handleRequest<ptzf::message::PtzfExecComp>);
+    select_.addReadHandler(pt_lock_reply_mq_.getFD(), &pt_lock_reply_mq_, &common::MessageQueue::pend);
+    select_.addReadHandler(
+        pt_lock_timer_.getFD(), this, &PtzfControllerMessageHandler::handlePanTiltLockTransitionTimer);
+
     recv_.setHandler(this, &PtzfControllerMessageHandler::handleRequest<PowerOnResult>);
     recv_.setHandler(this, &PtzfControllerMessageHandler::handleRequest<PowerOffResult>);
     recv_.setHandler(this, &PtzfControllerMessageHandler::handleRequest<Initialize>);
@@ -425,6 +452,10 @@ PtzfControllerMessageHandler::~PtzfControllerMessageHandler()
     global_.unregisterNotify<bizglobal::PanTiltAccelerationRampCurve>(&sendRampCurveMode);
     global_.unregisterNotify<bizglobal::PtMiconPowerOnCompStatus>(&sendPtMiconPowerOnCompStatus);
     global_.unregisterNotify<bizglobal::PtpAvailability>(&sendPtpAvailability);
+    pt_lock_timer_.stop();
+    select_.delReadHandler(pt_lock_timer_.getFD());
+    select_.delReadHandler(pt_lock_reply_mq_.getFD());
+    pt_lock_reply_mq_.unlink();
     select_.delReadHandler(mq_.getFD());
     mq_.unlink();
 }
@@ -452,6 +483,8 @@ void PtzfControllerMessageHandler::handleBypassMessage(const Message& msg)
 void PtzfControllerMessageHandler::doHandleRequest(const PowerOn&)
 {
     PTZF_TRACE_RECORD();
+    invalidatePowerStatusCache();
+    cancelPanTiltLockTransition();
 
     // 監視周期タイマー起動 & イベント通知登録
     common::MessageQueue reply_mq;
@@ -469,6 +502,7 @@ void PtzfControllerMessageHandler::doHandleRequest(const PowerOn&)
 
     initialize_infra_if_.setPowerOnSequenceStatus(true, reply_mq.getName());
     reply_mq.pend(comp_message);
+    updatePowerOnSequenceCache(true);
 
     pan_tilt_lock_infra_if_.suppressLockStatusEvent(true, reply_mq.getName());
     reply_mq.pend(comp_message);
@@ -490,6 +524,8 @@ void PtzfControllerMessageHandler::doHandleRequest(const PowerOn&)
 void PtzfControllerMessageHandler::doHandleRequest(const PowerOff&)
 {
     PTZF_TRACE_RECORD();
+    invalidatePowerStatusCache();
+    cancelPanTiltLockTransition();
 
     // Finalize処理開始
     infra::PtzfFinalizeInfraIf finalize_infra_if;
@@ -497,6 +533,7 @@ void PtzfControllerMessageHandler::doHandleRequest(const PowerOff&)
     finalize_infra_if.setPowerOffSequenceStatus(true, reply_mq.getName());
     ptzf::message::PtzfExecComp comp_message;
     reply_mq.pend(comp_message);
+    updatePowerOffSequenceCache(true);
 
     // 電源断処理中, イベント送出を禁止する
     pan_tilt_lock_infra_if_.suppressLockStatusEvent(true, reply_mq.getName());
@@ -516,6 +553,8 @@ void PtzfControllerMessageHandler::doHandleRequest(const PowerOff&)
     }
     // clear error status
     status_.setPanTiltStatus(U32_T(0));
+    // 次回PowerOn後の位置通知を受信するまでは保持している現在位置を使用しない
+    live_position_ = PanTiltLivePosition();
 
     CONTAINER_FOREACH (ViscaCommandHandler& handler, visca_comp_queue_) {
         PTZF_VTRACE_RECORD(handler.seq_id, handler.packet_id, 0);
@@ -559,6 +598,9 @@ void PtzfControllerMessageHandler::doHandleRequest(const PowerOnResult& msg)
 
     initialize_infra_if_.setPowerOnSequenceStatus(false, local_mq.getName());
     local_mq.pend(comp_message);
+    updatePowerOnSequenceCache(false);
+    // 起動結果に応じた電源状態は電源管理側で確定するため, 次回判定時に読み直す
+    invalidatePowerStatusCache();
 
     power_infra_if.completePtMiconBoot(msg.result_power_on);
 }
@@ -598,6 +640,8 @@ void PtzfControllerMessageHandler::doHandleRequest(const PowerOffResult& msg)
     infra::PtzfFinalizeInfraIf finalize_infra_if;
     finalize_infra_if.setPowerOffSequenceStatus(false, reply_mq.getName());
     reply_mq.pend(comp_message);
+    updatePowerOffSequenceCache(false);
+    invalidatePowerStatusCache();
 }
 
 void PtzfControllerMessageHandler::doHandleRequest(const Initialize&)
@@ -629,14 +673,13 @@ void PtzfControllerMessageHandler::doHandleRequest(const PanTiltMoveRequest& msg
         return;
     }
 
-    PtzfStatusIf status_if;
-    u8_t round_pan_speed = status_if.roundPanMaxSpeed(msg.pan_speed);
-    u8_t round_tilt_speed = status_if.roundTiltMaxSpeed(msg.tilt_speed);
+    u8_t round_pan_speed = ptzf_status_if_.roundPanMaxSpeed(msg.pan_speed);
+    u8_t round_tilt_speed = ptzf_status_if_.roundTiltMaxSpeed(msg.tilt_speed);
     if (!msg.mq_name.isValid()) {
         controller_.moveSircsPanTilt(msg.direction);
     }
-    else if ((msg.pan_speed != PAN_TILT_SPEED_NA && !status_if.isValidPanSpeed(round_pan_speed))
-             || (msg.tilt_speed != PAN_TILT_SPEED_NA && !status_if.isValidTiltSpeed(round_tilt_speed))) {
+    else if ((msg.pan_speed != PAN_TILT_SPEED_NA && !ptzf_status_if_.isValidPanSpeed(round_pan_speed))
+             || (msg.tilt_speed != PAN_TILT_SPEED_NA && !ptzf_status_if_.isValidTiltSpeed(round_tilt_speed))) {
         // [MARCO] 速度が0のときの動作をコマンド仕様書の動作条件に合わせるため
         // VISCAのPan-Tilt 方向駆動での速度値の判定条件(isValidPan_TiltDirectionMove)に合わせた
         PTZF_VTRACE_ERROR_RECORD(msg.seq_id, round_pan_speed, round_tilt_speed);
@@ -854,6 +897,8 @@ void PtzfControllerMessageHandler::handleCore(const PanTiltResetRequest& msg,
 
     PanTiltResetReplyHandler handler(reply_name, seq_id);
     pan_tilt_reset_queue_.push_back(handler);
+    // PanTiltReset中はPtzfController側でシーケンス状態を設定するため, 保持している状態を破棄する
+    invalidatePowerSequenceCache();
 }
 
 void PtzfControllerMessageHandler::doHandleRequest(const ResetPanTiltAckReply&)
@@ -1044,8 +1089,7 @@ void PtzfControllerMessageHandler::doHandleRequest(const SetPanTiltSlowModeReque
 
     SetPanTiltSlowModeResult result(ERRORCODE_SUCCESS);
     common::MessageQueue reply(reply_name.name);
-    PtzfStatusIf status_if;
-    if (status_if.isConfiguringPanTiltSlowMode()) {
+    if (ptzf_status_if_.isConfiguringPanTiltSlowMode()) {
         PTZF_TRACE_ERROR_RECORD();
         result.err = ERRORCODE_EXEC;
         reply.post(result);
@@ -1061,8 +1105,7 @@ void PtzfControllerMessageHandler::doHandleRequest(const visca::ViscaMessageSequ
     common::MessageQueue reply(reply_name.name);
 
     ErrorCode err = ERRORCODE_SUCCESS;
-    PtzfStatusIf status_if;
-    if (status_if.isConfiguringPanTiltSlowMode()) {
+    if (ptzf_status_if_.isConfiguringPanTiltSlowMode()) {
         err = ERRORCODE_EXEC;
     }
     visca::AckResponse ack(err);
@@ -1081,8 +1124,7 @@ void PtzfControllerMessageHandler::doHandleRequest(const BizMessage<SetPanTiltSl
 {
     PTZF_VTRACE_RECORD(msg().enable, msg.seq_id, 0);
 
-    PtzfStatusIf status_if;
-    if (status_if.isConfiguringPanTiltSlowMode()) {
+    if (ptzf_status_if_.isConfiguringPanTiltSlowMode()) {
         PTZF_TRACE_ERROR_RECORD();
         if (msg.mq_name.isValid()) {
             common::MessageQueue reply(msg.mq_name.name);
@@ -1118,8 +1160,7 @@ void PtzfControllerMessageHandler::doHandleRequest(const SetPanTiltSpeedStepRequ
 
     SetPanTiltSpeedStepResult result(ERRORCODE_SUCCESS);
     common::MessageQueue reply(reply_name.name);
-    PtzfStatusIf status_if;
-    if (status_if.isConfiguringPanTiltSpeedStep()) {
+    if (ptzf_status_if_.isConfiguringPanTiltSpeedStep()) {
         PTZF_TRACE_ERROR_RECORD();
         result.err = ERRORCODE_EXEC;
         reply.post(result);
@@ -1135,8 +1176,7 @@ void PtzfControllerMessageHandler::doHandleRequest(const visca::ViscaMessageSequ
     common::MessageQueue reply(reply_name.name);
 
     ErrorCode err = ERRORCODE_SUCCESS;
-    PtzfStatusIf status_if;
-    if (status_if.isConfiguringPanTiltSpeedStep()) {
+    if (ptzf_status_if_.isConfiguringPanTiltSpeedStep()) {
         err = ERRORCODE_EXEC;
     }
     visca::AckResponse ack(err);
@@ -1155,8 +1195,7 @@ void PtzfControllerMessageHandler::doHandleRequest(const BizMessage<SetPanTiltSp
 {
     PTZF_VTRACE_RECORD(msg().speed_step, msg.seq_id, 0);
 
-    PtzfStatusIf status_if;
-    if (status_if.isConfiguringPanTiltSpeedStep()) {
+    if (ptzf_status_if_.isConfiguringPanTiltSpeedStep()) {
         PTZF_TRACE_ERROR_RECORD();
         if (msg.mq_name.isValid()) {
             common::MessageQueue reply(msg.mq_name.name);
@@ -1185,7 +1224,7 @@ void PtzfControllerMessageHandler::handleCore(const SetPanTiltSpeedStepRequest&
     mq.post(req);
 }
 
-bool isDisableImageFlip()
+bool isDisableImageFlip(const PtzfStatusIf& status_if)
 {
     infra::PtzfPanTiltInfraIf pan_tilt_infra_if;
     PanTiltEnabledState enable_state(PAN_TILT_ENABLED_STATE_UNKNOWN);
@@ -1194,8 +1233,7 @@ bool isDisableImageFlip()
         return true;
     }
 
-    PtzfStatusIf ptzf_if;
-    if ((ptzf_if.isConfiguringImageFlip() || ptzf_if.isConfiguringPanTiltLimit()) || !ptzf_if.isValidPosition()) {
+    if ((status_if.isConfiguringImageFlip() || status_if.isConfiguringPanTiltLimit()) || !status_if.isValidPosition()) {
         return true;
     }
 
@@ -1216,8 +1254,7 @@ void PtzfControllerMessageHandler::doHandleRequest(const SetImageFlipRequest& ms
 
     common::MessageQueue reply(reply_name.name);
     SetImageFlipResult result(ERRORCODE_SUCCESS);
-    PtzfStatusIf status_if;
-    if (isDisableImageFlip()) {
+    if (isDisableImageFlip(ptzf_status_if_)) {
         PTZF_TRACE_ERROR_RECORD();
         result.err = ERRORCODE_EXEC;
         reply.post(result);
@@ -1233,8 +1270,7 @@ void PtzfControllerMessageHandler::doHandleRequest(const visca::ViscaMessageSequ
     common::MessageQueue reply(reply_name.name);
 
     ErrorCode err = ERRORCODE_SUCCESS;
-    PtzfStatusIf status_if;
-    if (isDisableImageFlip()) {
+    if (isDisableImageFlip(ptzf_status_if_)) {
         err = ERRORCODE_EXEC;
     }
     visca::AckResponse ack(err);
@@ -1253,8 +1289,7 @@ void PtzfControllerMessageHandler::doHandleRequest(const BizMessage<SetImageFlip
 {
     PTZF_VTRACE_RECORD(msg().enable, msg.seq_id, 0);
 
-    PtzfStatusIf status_if;
-    if (isDisableImageFlip()) {
+    if (isDisableImageFlip(ptzf_status_if_)) {
         PTZF_TRACE_ERROR_RECORD();
         if (msg.mq_name.isValid()) {
             common::MessageQueue reply(msg.mq_name.name);
@@ -1283,8 +1318,7 @@ void PtzfControllerMessageHandler::handleCore(const SetImageFlipRequest& msg,
                                               const u32_t seq_id)
 {
     bool change_image_flip = false;
-    PtzfStatusIf status_if;
-    visca::PictureFlipMode picture_flip = status_if.getPanTiltImageFlipMode();
+    visca::PictureFlipMode picture_flip = ptzf_status_if_.getPanTiltImageFlipMode();
 
     if (msg.enable) {
         if (visca::PICTURE_FLIP_MODE_ON != picture_flip) {
@@ -1497,6 +1531,10 @@ void PtzfControllerMessageHandler::doHandleRequest(const PanTiltPositionStatus&
 {
     PTZF_VTRACE_RECORD(msg.pan, msg.tilt, msg.status);
 
+    live_position_.valid = true;
+    live_position_.pan = msg.pan;
+    live_position_.tilt = msg.tilt;
+
     status_.setPanTiltPosition(msg.pan, msg.tilt);
     status_.setPanTiltStatus(msg.status);
     ptz_trace_thread_mq_.post(msg);
@@ -1565,12 +1603,11 @@ void PtzfControllerMessageHandler::doHandleRequest(const visca::ViscaMessageSequ
 
 void PtzfControllerMessageHandler::doHandleRequest(const BizMessage<SetPanTiltLimitRequestForBiz>& msg)
 {
-    PtzfStatusIf ptzf_if;
     ErrorCode error = ERRORCODE_OUT_OF_RANGE;
 
     SetPanTiltLimitRequestForBiz req = msg();
     if (PAN_TILT_LIMIT_TYPE_UP_RIGHT == req.type) {
-        if ((ptzf_if.isValidPanLimitRight(req.pan)) && (ptzf_if.isValidTiltLimitUp(req.tilt))) {
+        if ((ptzf_status_if_.isValidPanLimitRight(req.pan)) && (ptzf_status_if_.isValidTiltLimitUp(req.tilt))) {
             PTZF_TRACE();
             PanTiltLimitPosition pt_limit =
                 PanTiltLimitPosition::createPanTiltLimitPositionUpRight(req.pan, req.tilt, true);
@@ -1579,7 +1616,7 @@ void PtzfControllerMessageHandler::doHandleRequest(const BizMessage<SetPanTiltLi
         }
     }
     else if (PAN_TILT_LIMIT_TYPE_DOWN_LEFT == req.type) {
-        if ((ptzf_if.isValidPanLimitLeft(req.pan)) && (ptzf_if.isValidTiltLimitDown(req.tilt))) {
+        if ((ptzf_status_if_.isValidPanLimitLeft(req.pan)) && (ptzf_status_if_.isValidTiltLimitDown(req.tilt))) {
             PTZF_TRACE();
             PanTiltLimitPosition pt_limit =
                 PanTiltLimitPosition::createPanTiltLimitPositionDownLeft(req.pan, req.tilt, true);
@@ -1675,8 +1712,7 @@ void PtzfControllerMessageHandler::doHandleRequest(const visca::ViscaMessageSequ
     common::MessageQueue reply(reply_name.name);
 
     ErrorCode err = ERRORCODE_SUCCESS;
-    PtzfStatusIf status_if;
-    if (status_if.isConfiguringIRCorrection()) {
+    if (ptzf_status_if_.isConfiguringIRCorrection()) {
         err = ERRORCODE_EXEC;
     }
     visca::AckResponse ack(err);
@@ -1700,8 +1736,7 @@ void PtzfControllerMessageHandler::doHandleRequest(const visca::ViscaMessageSequ
 
 void PtzfControllerMessageHandler::doHandleRequest(const BizMessage<SetIRCorrectionRequest>& msg)
 {
-    PtzfStatusIf status_if;
-    if (status_if.isConfiguringIRCorrection()) {
+    if (ptzf_status_if_.isConfiguringIRCorrection()) {
         PTZF_VTRACE_ERROR_RECORD(msg.seq_id, msg().ir_correction, 0);
         if (msg.mq_name.isValid()) {
             common::MessageQueue reply(msg.mq_name.name);
@@ -1803,6 +1838,7 @@ void PtzfControllerMessageHandler::doHandleRequest(const InitializePanTiltCompRe
     ptzf::message::PtzfExecComp comp_message;
     initialize_infra_if_.setPowerOnSequenceStatus(false, initialize_reply_mq.getName());
     initialize_reply_mq.pend(comp_message);
+    updatePowerOnSequenceCache(false);
 
     PanTiltResetReplyHandler handler = pan_tilt_reset_queue_.front();
     pan_tilt_reset_queue_.pop_front();
@@ -1958,7 +1994,6 @@ void PtzfControllerMessageHandler::doHandleRequest(const SetFocusAFTimerRequest&
 
 void PtzfControllerMessageHandler::doHandleRequest(const BizMessage<SetPanTiltLimitClearRequestForBiz>& msg)
 {
-    PtzfStatusIf ptzf_if;
     ErrorCode error = ERRORCODE_OUT_OF_RANGE;
     common::MessageQueueName mq_name;
     gtl::copyString(mq_name.name, "");
@@ -2049,10 +2084,10 @@ void PtzfControllerMessageHandler::doHandleRequest(const SetPanTiltAbsolutePosit
         return;
     }
 
-    PtzfStatusIf status_if;
-    u8_t round_tilt_speed = status_if.roundTiltMaxSpeed(msg.tilt_speed);
-    if (!status_if.isValidSinPanAbsolute(msg.pan_position) || !status_if.isValidSinTiltAbsolute(msg.tilt_position)
-        || !status_if.isValidPanSpeed(msg.pan_speed) || !status_if.isValidTiltSpeed(round_tilt_speed)) {
+    u8_t round_tilt_speed = ptzf_status_if_.roundTiltMaxSpeed(msg.tilt_speed);
+    if (!ptzf_status_if_.isValidSinPanAbsolute(msg.pan_position)
+        || !ptzf_status_if_.isValidSinTiltAbsolute(msg.tilt_position)
+        || !ptzf_status_if_.isValidPanSpeed(msg.pan_speed) || !ptzf_status_if_.isValidTiltSpeed(round_tilt_speed)) {
         PTZF_VTRACE_ERROR_RECORD(msg.seq_id, msg.pan_position, msg.tilt_position);
         PTZF_VTRACE_ERROR_RECORD(msg.pan_speed, round_tilt_speed, 0);
         if (msg.mq_name.isValid()) {
@@ -2065,8 +2100,8 @@ void PtzfControllerMessageHandler::doHandleRequest(const SetPanTiltAbsolutePosit
 
     pan_tilt_infra_if_.movePanTiltAbsolute(msg.pan_speed,
                                            round_tilt_speed,
-                                           status_if.panSinDataToViscaData(msg.pan_position),
-                                           status_if.tiltSinDataToViscaData(msg.tilt_position),
+                                           ptzf_status_if_.panSinDataToViscaData(msg.pan_position),
+                                           ptzf_status_if_.tiltSinDataToViscaData(msg.tilt_position),
                                            msg.mq_name,
                                            msg.seq_id);
 }
@@ -2090,14 +2125,13 @@ void PtzfControllerMessageHandler::doHandleRequest(const SetPanTiltRelativePosit
 {
     PTZF_VTRACE(msg.seq_id, msg.pan_position, msg.pan_speed);
     PTZF_VTRACE(msg.tilt_position, msg.tilt_speed, 0);
-    PtzfStatusIf status_if;
     // [MARCO] 指定された相対値がSOFT ENDを超える場合はPan-Tilt動作させないように変更
     // （コマンド仕様書 Pan-Tilt相対値駆動 - 動作条件参照）
-    u8_t round_tilt_speed = status_if.roundTiltMaxSpeed(msg.tilt_speed);
-    if (!status_if.isValidSinPanRelative(msg.pan_position) || !status_if.isValidSinTiltRelative(msg.tilt_position)
-        || !status_if.isValidPanSpeed(msg.pan_speed) || !status_if.isValidTiltSpeed(round_tilt_speed)
-        || !status_if.isValidSinPanRelativeMoveRange(msg.pan_position)
-        || !status_if.isValidSinTiltRelativeMoveRange(msg.tilt_position)) {
+    u8_t round_tilt_speed = ptzf_status_if_.roundTiltMaxSpeed(msg.tilt_speed);
+    if (!ptzf_status_if_.isValidSinPanRelative(msg.pan_position)
+        || !ptzf_status_if_.isValidSinTiltRelative(msg.tilt_position)
+        || !ptzf_status_if_.isValidPanSpeed(msg.pan_speed) || !ptzf_status_if_.isValidTiltSpeed(round_tilt_speed)
+        || !isValidSinPanTiltRelativeMoveRange(msg.pan_position, msg.tilt_position)) {
         PTZF_VTRACE_ERROR_RECORD(msg.seq_id, msg.pan_position, msg.tilt_position);
         PTZF_VTRACE_ERROR_RECORD(msg.pan_speed, round_tilt_speed, 0);
         if (msg.mq_name.isValid()) {
@@ -2110,12 +2144,24 @@ void PtzfControllerMessageHandler::doHandleRequest(const SetPanTiltRelativePosit
 
     pan_tilt_infra_if_.movePanTiltRelative(msg.pan_speed,
                                            round_tilt_speed,
-                                           status_if.panSinDataToViscaData(msg.pan_position),
-                                           status_if.tiltSinDataToViscaData(msg.tilt_position),
+                                           ptzf_status_if_.panSinDataToViscaData(msg.pan_position),
+                                           ptzf_status_if_.tiltSinDataToViscaData(msg.tilt_position),
                                            msg.mq_name,
                                            msg.seq_id);
 }
 
+bool PtzfControllerMessageHandler::isValidSinPanTiltRelativeMoveRange(const s32_t sin_pan_move_position,
+                                                                      const s32_t sin_tilt_move_position) const
+{
+    // PanTiltPositionStatus通知を受信済みであれば、保持している現在位置で判定しStatusの読み出しを行わない
+    if (live_position_.valid) {
+        return ptzf_status_if_.isValidSinPanRelativeMoveRange(sin_pan_move_position, live_position_.pan)
+               && ptzf_status_if_.isValidSinTiltRelativeMoveRange(sin_tilt_move_position, live_position_.tilt);
+    }
+    return ptzf_status_if_.isValidSinPanRelativeMoveRange(sin_pan_move_position)
+           && ptzf_status_if_.isValidSinTiltRelativeMoveRange(sin_tilt_move_position);
+}
+
 void PtzfControllerMessageHandler::handleViscaPanTiltRelativePositionResponse(
     const u32_t,
     const u32_t,
@@ -2266,8 +2312,7 @@ void PtzfControllerMessageHandler::doHandleRequest(const bizglobal::PanTiltAccel
     PTZF_VTRACE(is_valid, mode, 0);
 
     if (is_valid) {
-        PtzfStatusIf status_if;
-        uint8_t current_mode = status_if.getPanTiltRampCurve();
+        uint8_t current_mode = ptzf_status_if_.getPanTiltRampCurve();
         if (mode != current_mode) {
             PTZF_TRACE();
             // 不正値が通知された場合はここで抑制
@@ -2291,8 +2336,7 @@ void PtzfControllerMessageHandler::doHandleRequest(const bizglobal::PtpAvailabil
 {
     PTZF_VTRACE(msg.is_available_, 0, 0);
     if (msg.is_available_) {
-        PtzfStatusIf status_if;
-        uint8_t current_mode = status_if.getPanTiltRampCurve();
+        uint8_t current_mode = ptzf_status_if_.getPanTiltRampCurve();
         pan_tilt_infra_if_.syncRampCurveMenu(current_mode);
     }
 }
@@ -2303,8 +2347,7 @@ void PtzfControllerMessageHandler::doHandleRequest(const infra::PanTiltLockStatu
 
     // 現在の電源状態を取得
     // 起動処理中・停止処理中の場合は、状態遷移を行わない
-    power::PowerStatusIf power_status_if;
-    power::PowerStatus power_status = power_status_if.getPowerStatus();
+    const power::PowerStatus power_status = getPowerStatusCache();
     if ((power_status == power::PowerStatus::PROCESSING_ON) || (power_status == power::PowerStatus::PROCESSING_OFF)) {
         PTZF_VTRACE(power_status, 0, 0);
         return;
@@ -2313,8 +2356,7 @@ void PtzfControllerMessageHandler::doHandleRequest(const infra::PanTiltLockStatu
     // PTブロックのInitialize / Finalize実行中は遷移処理を行わない
     bool is_initializing = false;
     bool is_finalizing = false;
-    status_infra_if_.getPowerOnSequenceStatus(is_initializing);
-    status_infra_if_.getPowerOffSequenceStatus(is_finalizing);
+    getPowerSequenceCache(is_initializing, is_finalizing);
     if (is_initializing || is_finalizing) {
         PTZF_VTRACE(is_initializing, is_finalizing, 0);
         return;
@@ -2325,14 +2367,7 @@ void PtzfControllerMessageHandler::doHandleRequest(const infra::PanTiltLockStatu
         return;
     }
 
-    PanTiltLockHandlerFunc next_func = getPtLockFuncNext();
-    if (next_func) {
-        setPanTiltLockTransitionExecuting(true);
-        (this->*next_func)();
-    }
-    else {
-        setPanTiltLockTransitionExecuting(false);
-    }
+    handlePanTiltLockTransitionNext();
 }
 
 void PtzfControllerMessageHandler::doHandleRequest(const FinalizePanTiltResult& msg)
@@ -2375,15 +2410,16 @@ void PtzfControllerMessageHandler::handleUnlockToLockWithPowerOnPTPowerOff()
     pt_finalizing_status_ = PanTiltFinalizingProcessingStatus::PAN_TILT_POWER_OFF;
 
     // Finalize処理中に変更
-    infra::PtzfFinalizeInfraIf finalize_infra_if;
-    common::MessageQueue reply_mq;
-    ptzf::message::PtzfExecComp comp_message;
-    finalize_infra_if.setPowerOffSequenceStatus(true, reply_mq.getName());
-    reply_mq.pend(comp_message);
-
+    pushPanTiltLockOperation(PanTiltLockOperation::SET_POWER_OFF_SEQUENCE, true);
     // 電源断処理中, イベント送出を禁止する
-    pan_tilt_lock_infra_if_.suppressLockStatusEvent(true, reply_mq.getName());
-    reply_mq.pend(comp_message);
+    pushPanTiltLockOperation(PanTiltLockOperation::SUPPRESS_LOCK_STATUS_EVENT, true);
+    startPanTiltLockOperations(&PtzfControllerMessageHandler::handleUnlockToLockWithPowerOnPTPowerOffRequest);
+}
+
+// PowerON中 Unlock --> Lock処理 (step2: PT電源断要求)
+void PtzfControllerMessageHandler::handleUnlockToLockWithPowerOnPTPowerOffRequest()
+{
+    PTZF_TRACE();
 
     // PT Power OFF
     u32_t seq_id = seq_controller_.createSeqId();
@@ -2409,24 +2445,10 @@ void PtzfControllerMessageHandler::handleUnlockToLockWithPowerOnDone()
     initialize_infra_if.setPanTiltFunctionLimitForCamera(true);
 
     // イベント送出を許可
-    common::MessageQueue reply_mq;
-    pan_tilt_lock_infra_if_.suppressLockStatusEvent(false, reply_mq.getName());
-    ptzf::message::PtzfExecComp comp_message;
-    reply_mq.pend(comp_message);
-
+    pushPanTiltLockOperation(PanTiltLockOperation::SUPPRESS_LOCK_STATUS_EVENT, false);
     // Finalize処理終了
-    infra::PtzfFinalizeInfraIf finalize_infra_if;
-    finalize_infra_if.setPowerOffSequenceStatus(false, reply_mq.getName());
-    reply_mq.pend(comp_message);
-
-    PanTiltLockHandlerFunc next_func = getPtLockFuncNext();
-    if (next_func) {
-        setPanTiltLockTransitionExecuting(true);
-        (this->*next_func)();
-    }
-    else {
-        setPanTiltLockTransitionExecuting(false);
-    }
+    pushPanTiltLockOperation(PanTiltLockOperation::SET_POWER_OFF_SEQUENCE, false);
+    startPanTiltLockOperations(&PtzfControllerMessageHandler::handlePanTiltLockTransitionNext);
 }
 
 // PowerOFF中 Unlock --> Lock処理 (制御状態更新のみ)
@@ -2442,14 +2464,7 @@ void PtzfControllerMessageHandler::handleUnlockToLockWithPowerOffDone()
     PtzfStatus ptzf_statis;
     ptzf_statis.setPanTiltLockControlStatus(next_control_state);
 
-    PanTiltLockHandlerFunc next_func = getPtLockFuncNext();
-    if (next_func) {
-        setPanTiltLockTransitionExecuting(true);
-        (this->*next_func)();
-    }
-    else {
-        setPanTiltLockTransitionExecuting(false);
-    }
+    handlePanTiltLockTransitionNext();
 }
 
 // PowerON中 Lock --> Unlock処理 (step1: PT電源供給処理開始)
@@ -2469,15 +2484,16 @@ void PtzfControllerMessageHandler::handleLockToUnlockWithPowerOnPTPowerOn()
     }
 
     // Initialize処理中に変更
-    infra::PtzfInitializeInfraIf initialize_infra_if;
-    common::MessageQueue reply_mq;
-    ptzf::message::PtzfExecComp comp_message;
-    initialize_infra_if.setPowerOnSequenceStatus(true, reply_mq.getName());
-    reply_mq.pend(comp_message);
-
+    pushPanTiltLockOperation(PanTiltLockOperation::SET_POWER_ON_SEQUENCE, true);
     // 電源供給処理中, イベント送出を禁止する
-    pan_tilt_lock_infra_if_.suppressLockStatusEvent(true, reply_mq.getName());
-    reply_mq.pend(comp_message);
+    pushPanTiltLockOperation(PanTiltLockOperation::SUPPRESS_LOCK_STATUS_EVENT, true);
+    startPanTiltLockOperations(&PtzfControllerMessageHandler::handleLockToUnlockWithPowerOnPTPowerOnRequest);
+}
+
+// PowerON中 Lock --> Unlock処理 (step1: PT電源供給要求)
+void PtzfControllerMessageHandler::handleLockToUnlockWithPowerOnPTPowerOnRequest()
+{
+    PTZF_TRACE();
 
     // PT Power ON
     u32_t seq_id = seq_controller_.createSeqId();
@@ -2508,24 +2524,10 @@ void PtzfControllerMessageHandler::handleLockToUnlockWithPowerOnDone()
     ptzf_status.setPanTiltLockControlStatus(next_control_state);
 
     // イベント送出を許可
-    common::MessageQueue reply_mq;
-    pan_tilt_lock_infra_if_.suppressLockStatusEvent(false, reply_mq.getName());
-    ptzf::message::PtzfExecComp comp_message;
-    reply_mq.pend(comp_message);
-
+    pushPanTiltLockOperation(PanTiltLockOperation::SUPPRESS_LOCK_STATUS_EVENT, false);
     // Initialize処理終了
-    infra::PtzfInitializeInfraIf initialize_infra_if;
-    initialize_infra_if.setPowerOnSequenceStatus(false, reply_mq.getName());
-    reply_mq.pend(comp_message);
-
-    PanTiltLockHandlerFunc next_func = getPtLockFuncNext();
-    if (next_func) {
-        setPanTiltLockTransitionExecuting(true);
-        (this->*next_func)();
-    }
-    else {
-        setPanTiltLockTransitionExecuting(false);
-    }
+    pushPanTiltLockOperation(PanTiltLockOperation::SET_POWER_ON_SEQUENCE, false);
+    startPanTiltLockOperations(&PtzfControllerMessageHandler::handlePanTiltLockTransitionNext);
 }
 
 // PowerON中 Lock --> Unlock処理 (制御状態更新のみ)
@@ -2549,14 +2551,7 @@ void PtzfControllerMessageHandler::handleLockToUnlockWithPowerOffDone()
     PtzfStatus ptzf_status;
     ptzf_status.setPanTiltLockControlStatus(next_control_state);
 
-    PanTiltLockHandlerFunc next_func = getPtLockFuncNext();
-    if (next_func) {
-        setPanTiltLockTransitionExecuting(true);
-        (this->*next_func)();
-    }
-    else {
-        setPanTiltLockTransitionExecuting(false);
-    }
+    handlePanTiltLockTransitionNext();
 }
 
 void PtzfControllerMessageHandler::handleAbortLockToUnlockPTPowerOff()
@@ -2565,14 +2560,20 @@ void PtzfControllerMessageHandler::handleAbortLockToUnlockPTPowerOff()
     pt_initializing_status_ = PanTiltInitializingProcessingStatus::NONE;
 
     // 通常のUNLOCK --> LOCKシーケンスに移行
-    handleUnlockToLockWithPowerOnPTPowerOff();
+    pt_finalizing_status_ = PanTiltFinalizingProcessingStatus::PAN_TILT_POWER_OFF;
+    pushPanTiltLockOperation(PanTiltLockOperation::SET_POWER_OFF_SEQUENCE, true);
+    pushPanTiltLockOperation(PanTiltLockOperation::SUPPRESS_LOCK_STATUS_EVENT, true);
+    startPanTiltLockOperations(&PtzfControllerMessageHandler::handleAbortLockToUnlockPTPowerOffRequest);
+}
 
-    // Initialize処理終了
-    infra::PtzfInitializeInfraIf initialize_infra_if;
-    common::MessageQueue reply_mq;
-    initialize_infra_if.setPowerOnSequenceStatus(false, reply_mq.getName());
-    ptzf::message::PtzfExecComp comp_message;
-    reply_mq.pend(comp_message);
+void PtzfControllerMessageHandler::handleAbortLockToUnlockPTPowerOffRequest()
+{
+    PTZF_TRACE();
+    handleUnlockToLockWithPowerOnPTPowerOffRequest();
+
+    // Initialize処理終了 (PT電源断要求の後に行う)
+    pushPanTiltLockOperation(PanTiltLockOperation::SET_POWER_ON_SEQUENCE, false);
+    startPanTiltLockOperations(nullptr);
 }
 
 void PtzfControllerMessageHandler::handleAbortLockToUnlockDone()
@@ -2587,14 +2588,7 @@ void PtzfControllerMessageHandler::handleAbortLockToUnlockDone()
     PtzfStatus ptzf_status;
     ptzf_status.setPanTiltLockControlStatus(next_control_state);
 
-    PanTiltLockHandlerFunc next_func = getPtLockFuncNext();
-    if (next_func) {
-        setPanTiltLockTransitionExecuting(true);
-        (this->*next_func)();
-    }
-    else {
-        setPanTiltLockTransitionExecuting(false);
-    }
+    handlePanTiltLockTransitionNext();
 }
 
 PtzfControllerMessageHandler::PanTiltLockHandlerFunc PtzfControllerMessageHandler::getPtLockFuncNext()
@@ -2613,8 +2607,7 @@ PtzfControllerMessageHandler::PanTiltLockHandlerFunc PtzfControllerMessageHandle
         return nullptr;
     }
 
-    power::PowerStatusIf power_status_if;
-    const power::PowerStatus power_status = power_status_if.getPowerStatus();
+    const power::PowerStatus power_status = getPowerStatusCache();
     if ((power_status == power::PowerStatus::PROCESSING_ON) || (power_status == power::PowerStatus::PROCESSING_OFF)) {
         return nullptr;
     }
@@ -2673,8 +2666,16 @@ PtzfControllerMessageHandler::PanTiltLockHandlerFunc PtzfControllerMessageHandle
     return ret_func;
 }
 
+// 完了期限は遷移処理ごとに設定し直す (連続する遷移処理の合計時間では判定しない)
 void PtzfControllerMessageHandler::setPanTiltLockTransitionExecuting(const bool status)
 {
+    if (status) {
+        pt_lock_transition_start_msec_ = getMonotonicTimeMsec();
+        setPanTiltLockTransitionTimer(true);
+    }
+    else {
+        setPanTiltLockTransitionTimer(false);
+    }
     pt_transition_executing_ = status;
 }
 bool PtzfControllerMessageHandler::getPanTiltLockTransitionExecuting()
@@ -2682,4 +2683,269 @@ bool PtzfControllerMessageHandler::getPanTiltLockTransitionExecuting()
     return pt_transition_executing_;
 }
 
+void PtzfControllerMessageHandler::handlePanTiltLockTransitionNext()
+{
+    PanTiltLockHandlerFunc next_func = getPtLockFuncNext();
+    if (next_func) {
+        setPanTiltLockTransitionExecuting(true);
+        (this->*next_func)();
+    }
+    else {
+        setPanTiltLockTransitionExecuting(false);
+    }
+}
+
+void PtzfControllerMessageHandler::pushPanTiltLockOperation(const PanTiltLockOperation operation, const bool value)
+{
+    pt_lock_operation_queue_.push_back(PanTiltLockOperationRequest(operation, value, pt_lock_transition_id_));
+}
+
+// 積まれた操作を1つずつ非同期に実行し, 全て完了したらcontinuationを呼び出す (nullptrの場合は何もしない)
+// 完了待ちの間もmq_/recv_のメッセージは処理される
+void PtzfControllerMessageHandler::startPanTiltLockOperations(const PanTiltLockHandlerFunc continuation)
+{
+    if (pt_lock_operation_queue_.empty() || (pt_lock_operation_queue_.back().transition_id != pt_lock_transition_id_)) {
+        pt_lock_continuation_ = nullptr;
+        if (continuation) {
+            (this->*continuation)();
+        }
+        return;
+    }
+    pt_lock_continuation_ = continuation;
+    // 中断前の操作が完了待ちの場合は, その完了通知を受けてから実行する
+    if (!pt_lock_operation_in_flight_) {
+        executePanTiltLockOperation();
+    }
+}
+
+void PtzfControllerMessageHandler::executePanTiltLockOperation()
+{
+    const PanTiltLockOperationRequest& request = pt_lock_operation_queue_.front();
+    PTZF_VTRACE_RECORD(request.operation, request.value, pt_lock_operation_queue_.size());
+    pt_lock_operation_in_flight_ = true;
+    sendPanTiltLockOperation(request.operation, request.value, pt_lock_reply_mq_);
+}
+
+// 要求した時点の設定値を記録し, 完了通知はreply_mqで受ける
+void PtzfControllerMessageHandler::sendPanTiltLockOperation(const PanTiltLockOperation operation,
+                                                            const bool value,
+                                                            common::MessageQueue& reply_mq)
+{
+    switch (operation) {
+    case PanTiltLockOperation::SET_POWER_ON_SEQUENCE: {
+        infra::PtzfInitializeInfraIf initialize_infra_if;
+        initialize_infra_if.setPowerOnSequenceStatus(value, reply_mq.getName());
+        pt_lock_requested_status_.power_on_sequence = value;
+        break;
+    }
+    case PanTiltLockOperation::SET_POWER_OFF_SEQUENCE: {
+        infra::PtzfFinalizeInfraIf finalize_infra_if;
+        finalize_infra_if.setPowerOffSequenceStatus(value, reply_mq.getName());
+        pt_lock_requested_status_.power_off_sequence = value;
+        break;
+    }
+    case PanTiltLockOperation::SUPPRESS_LOCK_STATUS_EVENT:
+        pan_tilt_lock_infra_if_.suppressLockStatusEvent(value, reply_mq.getName());
+        pt_lock_requested_status_.suppress_lock_status_event = value;
+        break;
+    default:
+        PTZF_VTRACE_ERROR_RECORD(operation, 0, 0);
+        break;
+    }
+}
+
+void PtzfControllerMessageHandler::doHandleRequest(const ptzf::message::PtzfExecComp&)
+{
+    if (!pt_lock_operation_in_flight_ || pt_lock_operation_queue_.empty()) {
+        // 要求していない完了通知
+        PTZF_TRACE_ERROR();
+        return;
+    }
+    pt_lock_operation_in_flight_ = false;
+
+    const PanTiltLockOperationRequest request = pt_lock_operation_queue_.front();
+    pt_lock_operation_queue_.pop_front();
+    PTZF_VTRACE_RECORD(request.operation, request.value, getMonotonicTimeMsec() - pt_lock_transition_start_msec_);
+
+    if (request.transition_id != pt_lock_transition_id_) {
+        // 中断・取消済みの遷移処理の操作は, 以降の設定で上書きされるため結果を反映しない
+        PTZF_VTRACE_RECORD(request.transition_id, pt_lock_transition_id_, 0);
+    }
+    else if (request.operation == PanTiltLockOperation::SET_POWER_ON_SEQUENCE) {
+        updatePowerOnSequenceCache(request.value);
+    }
+    else if (request.operation == PanTiltLockOperation::SET_POWER_OFF_SEQUENCE) {
+        updatePowerOffSequenceCache(request.value);
+    }
+
+    if (!pt_lock_operation_queue_.empty()) {
+        executePanTiltLockOperation();
+        return;
+    }
+
+    const PanTiltLockHandlerFunc continuation = pt_lock_continuation_;
+    pt_lock_continuation_ = nullptr;
+    if (continuation) {
+        (this->*continuation)();
+    }
+}
+
+// 遷移処理中はイベント通知を抑止しているため, 完了期限はselect_に登録したタイマーで監視する
+void PtzfControllerMessageHandler::setPanTiltLockTransitionTimer(const bool enable)
+{
+    // 実行中のタイマーは停止してから設定し直す
+    pt_lock_timer_.stop();
+    if (enable) {
+        pt_lock_timer_.start(PAN_TILT_LOCK_TRANSITION_TIMEOUT_MSEC);
+    }
+}
+
+void PtzfControllerMessageHandler::handlePanTiltLockTransitionTimer()
+{
+    // 満了したタイマーを停止し, 再設定されるまで通知を受けないようにする
+    pt_lock_timer_.stop();
+    PanTiltLockTransitionTimeout timeout_message;
+    handleRequest(timeout_message);
+}
+
+void PtzfControllerMessageHandler::doHandleRequest(const PanTiltLockTransitionTimeout&)
+{
+    if (!getPanTiltLockTransitionExecuting()) {
+        PTZF_TRACE();
+        return;
+    }
+    // 遷移処理が期限内に完了していないため中断し, 状態を戻した上で再判定する
+    abortPanTiltLockTransition();
+}
+
+void PtzfControllerMessageHandler::abortPanTiltLockTransition()
+{
+    pf(common::Log::LOG_LEVEL_ERROR,
+       "PanTilt lock transition timeout (initializing:%d, finalizing:%d, operations:%d)\n",
+       static_cast<int>(pt_initializing_status_),
+       static_cast<int>(pt_finalizing_status_),
+       static_cast<int>(pt_lock_operation_queue_.size()));
+    PTZF_VTRACE_ERROR_RECORD(pt_initializing_status_, pt_finalizing_status_, pt_lock_operation_queue_.size());
+
+    // 要求済みのPT電源供給・電源断の完了通知は, seq_idが一致し処理状態がNONEの通知として破棄させる
+    pt_initializing_status_ = PanTiltInitializingProcessingStatus::NONE;
+    pt_finalizing_status_ = PanTiltFinalizingProcessingStatus::NONE;
+    discardPanTiltLockOperations();
+    pt_lock_transition_start_msec_ = getMonotonicTimeMsec();
+    setPanTiltLockTransitionTimer(true);
+
+    // シーケンス状態とイベント抑止を解除してから, 現在のLock状態で遷移を再判定する
+    pushPanTiltLockOperation(PanTiltLockOperation::SET_POWER_ON_SEQUENCE, false);
+    pushPanTiltLockOperation(PanTiltLockOperation::SET_POWER_OFF_SEQUENCE, false);
+    pushPanTiltLockOperation(PanTiltLockOperation::SUPPRESS_LOCK_STATUS_EVENT, false);
+    startPanTiltLockOperations(&PtzfControllerMessageHandler::handlePanTiltLockTransitionNext);
+}
+
+// PowerOn/PowerOffで設定するシーケンス状態・イベント抑止を, 遷移処理の残りの操作で上書きしないよう取り消す
+// Lock状態は電源処理の完了後に受信するイベントで再判定する
+void PtzfControllerMessageHandler::cancelPanTiltLockTransition()
+{
+    if (!getPanTiltLockTransitionExecuting() && pt_lock_operation_queue_.empty()) {
+        return;
+    }
+    PTZF_VTRACE_RECORD(pt_initializing_status_, pt_finalizing_status_, pt_lock_operation_queue_.size());
+
+    // 要求済みのPT電源供給・電源断の完了通知は, seq_idが一致し処理状態がNONEの通知として破棄させる
+    pt_initializing_status_ = PanTiltInitializingProcessingStatus::NONE;
+    pt_finalizing_status_ = PanTiltFinalizingProcessingStatus::NONE;
+    discardPanTiltLockOperations();
+
+    // 遷移処理で設定済みのシーケンス状態・イベント抑止は, PowerOn/PowerOffの設定より前に解除する
+    // 完了待ちの操作の後に処理されるため, その完了通知は取消済みの操作として破棄される
+    common::MessageQueue reply_mq;
+    ptzf::message::PtzfExecComp comp_message;
+    if (pt_lock_requested_status_.power_on_sequence) {
+        sendPanTiltLockOperation(PanTiltLockOperation::SET_POWER_ON_SEQUENCE, false, reply_mq);
+        reply_mq.pend(comp_message);
+        updatePowerOnSequenceCache(false);
+    }
+    if (pt_lock_requested_status_.power_off_sequence) {
+        sendPanTiltLockOperation(PanTiltLockOperation::SET_POWER_OFF_SEQUENCE, false, reply_mq);
+        reply_mq.pend(comp_message);
+        updatePowerOffSequenceCache(false);
+    }
+    if (pt_lock_requested_status_.suppress_lock_status_event) {
+        sendPanTiltLockOperation(PanTiltLockOperation::SUPPRESS_LOCK_STATUS_EVENT, false, reply_mq);
+        reply_mq.pend(comp_message);
+    }
+    setPanTiltLockTransitionExecuting(false);
+}
+
+// 未実行の操作を破棄する
+// 完了待ちの操作は取り消せないため, 完了通知を受けるまで先頭に残し, 以降の操作はその後に実行する
+void PtzfControllerMessageHandler::discardPanTiltLockOperations()
+{
+    ++pt_lock_transition_id_;
+    pt_lock_continuation_ = nullptr;
+    if (pt_lock_operation_in_flight_) {
+        pt_lock_operation_queue_.erase(pt_lock_operation_queue_.begin() + 1, pt_lock_operation_queue_.end());
+    }
+    else {
+        pt_lock_operation_queue_.clear();
+    }
+}
+
+power::PowerStatus PtzfControllerMessageHandler::getPowerStatusCache()
+{
+    if (power_sequence_cache_.power_status_loaded) {
+        return power_sequence_cache_.power_status;
+    }
+
+    // 起動処理中・停止処理中は電源管理側で状態が変化するため保持せず, 次回も読み出す
+    // 安定状態はPowerOn/PowerOffを受信するまで変化しないため, 破棄されるまで保持する
+    power::PowerStatusIf power_status_if;
+    const power::PowerStatus status = power_status_if.getPowerStatus();
+    PTZF_VTRACE_RECORD(status, 0, 0);
+    power_sequence_cache_.power_status = status;
+    power_sequence_cache_.power_status_loaded =
+        (status == power::PowerStatus::POWER_ON) || (status == power::PowerStatus::POWER_OFF);
+    return status;
+}
+
+void PtzfControllerMessageHandler::invalidatePowerStatusCache()
+{
+    power_sequence_cache_.power_status_loaded = false;
+}
+
+void PtzfControllerMessageHandler::getPowerSequenceCache(bool& is_initializing, bool& is_finalizing)
+{
+    if (!power_sequence_cache_.sequence_loaded) {
+        bool power_on_sequence = false;
+        bool power_off_sequence = false;
+        status_infra_if_.getPowerOnSequenceStatus(power_on_sequence);
+        status_infra_if_.getPowerOffSequenceStatus(power_off_sequence);
+        PTZF_VTRACE_RECORD(power_on_sequence, power_off_sequence, 0);
+        power_sequence_cache_.power_on_sequence = power_on_sequence;
+        power_sequence_cache_.power_off_sequence = power_off_sequence;
+        // PanTiltReset中はPtzfController側でシーケンス状態を設定するため, 完了するまで保持しない
+        power_sequence_cache_.sequence_loaded = pan_tilt_reset_queue_.empty();
+    }
+    is_initializing = power_sequence_cache_.power_on_sequence;
+    is_finalizing = power_sequence_cache_.power_off_sequence;
+}
+
+void PtzfControllerMessageHandler::invalidatePowerSequenceCache()
+{
+    power_sequence_cache_.sequence_loaded = false;
+}
+
+void PtzfControllerMessageHandler::updatePowerOnSequenceCache(const bool status)
+{
+    if (power_sequence_cache_.sequence_loaded) {
+        power_sequence_cache_.power_on_sequence = status;
+    }
+}
+
+void PtzfControllerMessageHandler::updatePowerOffSequenceCache(const bool status)
+{
+    if (power_sequence_cache_.sequence_loaded) {
+        power_sequence_cache_.power_off_sequence = status;
+    }
+}
+
 } // namespace ptzf
@@ -12,6 +12,7 @@
 #include "types.h"
 
 #include "common_select.h"
+#include "common_timer.h"
 #include "common_message_queue.h"
 #include "common_thread_object.h"
 #include "ptzf_controller_initializer.h"
@@ -43,8 +44,10 @@
 #include "infra/ptzf_infra_message.h"
 #include "ptzf/ptzf_common_message.h"
 #include "ptzf/ptzf_config_if.h"
+#include "ptzf/ptzf_status_if.h"
 #include "infra/sequence_id_controller.h"
 #include "visca/visca_server_internal_mode_manager.h"
+#include "power/power_status_if.h"
 
 namespace bizglobal {
 class BizGlobal;
@@ -80,6 +83,76 @@ enum class PanTiltFinalizingProcessingStatus : uint8_t
     PAN_TILT_POWER_OFF,
 };
 
+// PT Lock/Unlock遷移処理で完了通知を待つ操作
+enum class PanTiltLockOperation : uint8_t
+{
+    SET_POWER_ON_SEQUENCE,
+    SET_POWER_OFF_SEQUENCE,
+    SUPPRESS_LOCK_STATUS_EVENT,
+};
+
+// 完了通知は要求順に返るため, 先頭の要求が完了待ちとなる
+// 中断・取消された遷移処理の要求はtransition_idで判別し, 完了通知を受けても結果を反映しない
+struct PanTiltLockOperationRequest
+{
+    PanTiltLockOperation operation;
+    bool value;
+    u32_t transition_id;
+
+    PanTiltLockOperationRequest(const PanTiltLockOperation op, const bool v, const u32_t id)
+        : operation(op),
+          value(v),
+          transition_id(id)
+    {}
+};
+
+// PT Lock/Unlock遷移処理から要求済みの設定値
+// 遷移処理の取消時は, trueを要求済みの設定のみ解除する
+struct PanTiltLockRequestedStatus
+{
+    bool power_on_sequence;
+    bool power_off_sequence;
+    bool suppress_lock_status_event;
+
+    PanTiltLockRequestedStatus() : power_on_sequence(false), power_off_sequence(false), suppress_lock_status_event(false)
+    {}
+};
+
+// PT Lock/Unlock遷移処理の完了期限を過ぎたことを示す通知
+struct PanTiltLockTransitionTimeout
+{};
+
+// PanTiltPositionStatus通知から更新するPan/Tilt現在位置(VISCA値)
+struct PanTiltLivePosition
+{
+    bool valid;
+    u32_t pan;
+    u32_t tilt;
+
+    PanTiltLivePosition() : valid(false), pan(0), tilt(0)
+    {}
+};
+
+// PanTiltLockStatusChangedEvent判定用に保持する電源状態・PTブロックのシーケンス状態
+// 電源状態はPowerStatusIfから読み出した安定状態(POWER_ON/POWER_OFF)のみ保持し, PowerOn/PowerOff系の通知で破棄する
+// シーケンス状態はPtzfControllerMessageHandler自身が設定した値で更新し, 他から設定され得る間は保持しない
+struct PanTiltPowerSequenceCache
+{
+    bool power_status_loaded;
+    power::PowerStatus power_status;
+    bool sequence_loaded;
+    bool power_on_sequence;
+    bool power_off_sequence;
+
+    PanTiltPowerSequenceCache()
+        : power_status_loaded(false),
+          power_status(power::PowerStatus::POWER_OFF),
+          sequence_loaded(false),
+          power_on_sequence(false),
+          power_off_sequence(false)
+    {}
+};
+
 class PtzfControllerMessageHandler
 {
 public:
@@ -288,6 +361,8 @@ private:
                                                     const u32_t seq_id);
 
     void doHandleRequest(const SetPanTiltRelativePositionRequest& msg);
+    bool isValidSinPanTiltRelativeMoveRange(const s32_t sin_pan_move_position,
+                                            const s32_t sin_tilt_move_position) const;
     void handleViscaPanTiltRelativePositionResponse(const u32_t param,
                                                     const u32_t packet_id,
                                                     const ErrorCode err,
@@ -324,19 +399,43 @@ private:
 
     void handleUnlockToLockWithPowerOnFinalize();
     void handleUnlockToLockWithPowerOnPTPowerOff();
+    void handleUnlockToLockWithPowerOnPTPowerOffRequest();
     void handleUnlockToLockWithPowerOnDone();
     void handleUnlockToLockWithPowerOffDone();
 
     void handleLockToUnlockWithPowerOnPTPowerOn();
+    void handleLockToUnlockWithPowerOnPTPowerOnRequest();
     void handleLockToUnlockWithPowerOnDone();
     void handleLockToUnlockWithPowerOffDone();
     void handleAbortLockToUnlockPTPowerOff();
+    void handleAbortLockToUnlockPTPowerOffRequest();
     void handleAbortLockToUnlockDone();
 
     typedef void (PtzfControllerMessageHandler::*PanTiltLockHandlerFunc)();
     PanTiltLockHandlerFunc getPtLockFuncNext();
     void setPanTiltLockTransitionExecuting(const bool status);
     bool getPanTiltLockTransitionExecuting();
+    void handlePanTiltLockTransitionNext();
+    void pushPanTiltLockOperation(const PanTiltLockOperation operation, const bool value);
+    void startPanTiltLockOperations(const PanTiltLockHandlerFunc continuation);
+    void executePanTiltLockOperation();
+    void sendPanTiltLockOperation(const PanTiltLockOperation operation,
+                                  const bool value,
+                                  common::MessageQueue& reply_mq);
+    void discardPanTiltLockOperations();
+    void doHandleRequest(const ptzf::message::PtzfExecComp& msg);
+    void setPanTiltLockTransitionTimer(const bool enable);
+    void handlePanTiltLockTransitionTimer();
+    void doHandleRequest(const PanTiltLockTransitionTimeout& msg);
+    void abortPanTiltLockTransition();
+    void cancelPanTiltLockTransition();
+
+    power::PowerStatus getPowerStatusCache();
+    void invalidatePowerStatusCache();
+    void getPowerSequenceCache(bool& is_initializing, bool& is_finalizing);
+    void invalidatePowerSequenceCache();
+    void updatePowerOnSequenceCache(const bool status);
+    void updatePowerOffSequenceCache(const bool status);
 
     event_router::EventRouterReceiver recv_;
     visca::ViscaServerMessageIf visca_if_;
@@ -364,6 +463,7 @@ private:
     common::MessageQueue ptz_trace_thread_mq_;
     PtzTraceController ptz_trace_controller_;
     infra::PtzfStatusInfraIf status_infra_if_;
+    PtzfStatusIf ptzf_status_if_;
     PtzfConfigIf config_if_;
     infra::PtzfPanTiltInfraIf pan_tilt_infra_if_;
     infra::PtzfZoomInfraIf zoom_infra_if_;
@@ -379,6 +479,16 @@ private:
     infra::SequenceIdController seq_controller_;
     visca::ViscaServerInternalModeManager internal_mode_manager_;
     bool pt_transition_executing_;
+    PanTiltLivePosition live_position_;
+    PanTiltPowerSequenceCache power_sequence_cache_;
+    common::MessageQueue pt_lock_reply_mq_;
+    std::deque<PanTiltLockOperationRequest> pt_lock_operation_queue_;
+    PanTiltLockHandlerFunc pt_lock_continuation_;
+    u32_t pt_lock_transition_id_;
+    bool pt_lock_operation_in_flight_;
+    PanTiltLockRequestedStatus pt_lock_requested_status_;
+    u32_t pt_lock_transition_start_msec_;
+    common::Timer pt_lock_timer_;
 };
 
 } // namespace ptzf
@@ -569,6 +569,15 @@ bool PtzfStatusIf::isValidSinPanRelativeMoveRange(const s32_t sin_pan_move_posit
 {
     u32_t current_pan = U32_T(0);
     u32_t current_tilt = U32_T(0);
+
+    // Current position (入力値の範囲チェックは現在位置を指定する版で行う)
+    getPanTiltPosition(current_pan, current_tilt);
+
+    return isValidSinPanRelativeMoveRange(sin_pan_move_position, current_pan);
+}
+
+bool PtzfStatusIf::isValidSinPanRelativeMoveRange(const s32_t sin_pan_move_position, const u32_t current_pan) const
+{
     s32_t sin_current_pan = S32_T(0);
     s32_t sin_pan_move_range = S32_T(0);
 
@@ -577,9 +586,6 @@ bool PtzfStatusIf::isValidSinPanRelativeMoveRange(const s32_t sin_pan_move_posit
         return false;
     }
 
-    // Current position
-    getPanTiltPosition(current_pan, current_tilt);
-
     // 取得したPosition値をSinDataに変換する
     sin_current_pan = pimpl_->value_manager_.panViscaDataToSinData(current_pan);
 
@@ -596,6 +602,15 @@ bool PtzfStatusIf::isValidSinTiltRelativeMoveRange(const s32_t sin_tilt_move_pos
 {
     u32_t current_pan = U32_T(0);
     u32_t current_tilt = U32_T(0);
+
+    // Current position (入力値の範囲チェックは現在位置を指定する版で行う)
+    getPanTiltPosition(current_pan, current_tilt);
+
+    return isValidSinTiltRelativeMoveRange(sin_tilt_move_position, current_tilt);
+}
+
+bool PtzfStatusIf::isValidSinTiltRelativeMoveRange(const s32_t sin_tilt_move_position, const u32_t current_tilt) const
+{
     s32_t sin_current_tilt = S32_T(0);
     s32_t sin_tilt_move_range = S32_T(0);
 
@@ -604,9 +619,6 @@ bool PtzfStatusIf::isValidSinTiltRelativeMoveRange(const s32_t sin_tilt_move_pos
         return false;
     }
 
-    // Current position
-    getPanTiltPosition(current_pan, current_tilt);
-
     // 取得したPosition値をSinDataに変換する
     sin_current_tilt = pimpl_->value_manager_.tiltViscaDataToSinData<u32_t>(current_tilt);
 
@@ -355,6 +355,30 @@ s32_t PtzfStatusIf::roundPTZTiltRelativeMoveRange(const s32_t sin_tilt_move_posi
     return mock.roundPTZTiltRelativeMoveRange(sin_tilt_move_position);
 }
 
+bool PtzfStatusIf::isValidSinPanRelativeMoveRange(const s32_t sin_pan_move_position) const
+{
+    PtzfStatusIfMock& mock = pimpl_->mock_holder.getMock();
+    return mock.isValidSinPanRelativeMoveRange(sin_pan_move_position);
+}
+
+bool PtzfStatusIf::isValidSinTiltRelativeMoveRange(const s32_t sin_tilt_move_position) const
+{
+    PtzfStatusIfMock& mock = pimpl_->mock_holder.getMock();
+    return mock.isValidSinTiltRelativeMoveRange(sin_tilt_move_position);
+}
+
+bool PtzfStatusIf::isValidSinPanRelativeMoveRange(const s32_t sin_pan_move_position, const u32_t current_pan) const
+{
+    PtzfStatusIfMock& mock = pimpl_->mock_holder.getMock();
+    return mock.isValidSinPanRelativeMoveRange(sin_pan_move_position, current_pan);
+}
+
+bool PtzfStatusIf::isValidSinTiltRelativeMoveRange(const s32_t sin_tilt_move_position, const u32_t current_tilt) const
+{
+    PtzfStatusIfMock& mock = pimpl_->mock_holder.getMock();
+    return mock.isValidSinTiltRelativeMoveRange(sin_tilt_move_position, current_tilt);
+}
+
 bool PtzfStatusIf::getPanLimitMode() const
 {
     PtzfStatusIfMock& mock = pimpl_->mock_holder.getMock();
@@ -71,6 +71,7 @@ using ::testing::Property;
 using ::testing::Field;
 using ::testing::StrCaseEq;
 using ::testing::InvokeWithoutArgs;
+using ::testing::Sequence;
 
 namespace config {
 
@@ -94,6 +95,19 @@ namespace ptzf {
 //   - PT Lock制御状態がロック状態の場合, ViscaServerにPanTiltPowerOnRequestを送らず, PowerOff完了メッセージを送ること
 //   - 共通処理としてPowerOFF処理中フラグをONにし, かつPT Lock/Unlock通知イベントを抑止すること
 // + PowerOffメッセージを受信したらPanTiltStateを初期化すること
+// + PT Lock/Unlock通知イベント受信時, 電源状態・シーケンス状態は初回のみ読み出し, 以降は保持している状態で判定すること
+//   - 起動処理中・停止処理中の電源状態は保持せず, イベント受信ごとに読み出すこと
+//   - PowerOn完了(起動失敗)を受信した後は, 電源状態をPOWER_ONとみなさずに読み直すこと
+//   - PanTiltReset中はシーケンス状態を保持せず, イベント受信ごとに読み出すこと
+//   - シーケンス状態を保持した後にPanTiltResetを受信した場合も, 保持している状態で判定しないこと
+// + PT Lock/Unlock遷移処理の完了待ち中も, 他のリクエストが遷移完了を待たずに処理されること
+// + PT Lock/Unlock遷移処理が完了期限を過ぎた場合, シーケンス状態とイベント抑止を解除して再判定すること
+//   - 期限切れ後に受信した遷移処理の完了通知では, Lock制御状態を更新しないこと
+//   - 遷移処理の完了後に期限切れを受信しても, 何もしないこと
+//   - 期限切れ後に受信したPT電源供給の完了通知を, 期限切れ後に受け付けた移動リクエストの完了として扱わないこと
+//   - 完了待ちの操作がある場合は, その完了通知を受けてから解除の操作を要求し, 中断前の完了通知で遷移処理を進めないこと
+// + PT Lock/Unlock遷移処理の途中でPowerOffを受信した場合, 遷移処理の残りの操作を要求しないこと
+//   - 完了待ちだった操作の完了通知を受けても, PowerOFF処理中フラグをOFFにしないこと
 // + PowerOff完了メッセージ受信時
 //   - PT Lock制御状態が通電アンロック状態の場合, Power Standbyかつアンロックの状態に遷移すること
 //   - 共通処理としてPowerOFF処理中フラグをOFFにし, かつPT Lock/Unlock通知イベントの抑止を解除すること
@@ -136,6 +150,7 @@ namespace ptzf {
 // + TouchFunctionInMfメッセージを受信したらViscaServerにTouchFunctionInMfを送ること(*)
 // + FocusAFTimerメッセージを受信したらViscaServerにFocusAFTimerを送ること(*)
 // + PanTiltRelativeMoveメッセージを受信したらViscaServerにPanTiltRelativeRequestを送ること(*)
+// + PanTiltPositionStatus受信後のPanTiltRelativePositionメッセージでは、Statusから現在位置を読み出さないこと
 // + ZoomRelativeMoveメッセージを受信したらViscaServerにZoomAbsolutePositionを送ること(*)
 // + HomePositionRequestメッセージを受信したらViscaServerにHomePositionRequestを送ること
 // + Finalizeメッセージを受信したらPtzfControllerFinalizer::finalize()を呼び出すこと
@@ -225,6 +240,7 @@ namespace ptzf {
 // + receiveLockToUnlockEventWithPowerOnCancel2
 //   - Lock-->Unlockのイベントを受信時のシーケンスにおいて, 処理中に再度Lock状態になった場合, それを検出する
 //   - この際, 電源供給処理実行後であった場合は, 電源供給を止める操作が実行されることを確認する
+//   - Initialize処理終了は, PT電源断要求の後に実行されることを確認する
 //   - 処理終了後にロック制御状態が更新されないことを確認する
 // + receiveLockToUnlockEventWithPowerOnFinalizing
 //   - PT Lock状態変化イベントを受信した際, 電源状態とPT Initialize/Finalize処理実行中かどうかを確認する
@@ -387,6 +403,15 @@ protected:
         }
     }
 
+    // PT Lock/Unlock遷移処理で要求した操作の完了通知を順に返す
+    void completePanTiltLockOperations(const u32_t count)
+    {
+        for (u32_t i = U32_T(0); i < count; ++i) {
+            ptzf::message::PtzfExecComp comp_message;
+            handler_->handleRequest(comp_message);
+        }
+    }
+
     void setDefaultValidCondition(const u16_t cardinality)
     {
         EXPECT_CALL(visca_status_if_mock_, isHandlingIfclearCommand()).Times(cardinality).WillRepeatedly(Return(false));
@@ -4670,6 +4695,39 @@ TEST_F(PtzfControllerMessageHandlerTest, PanTiltRelativePosition2wayMultiple)
     handler_->handleRequest(biz_msg2);
 }
 
+TEST_F(PtzfControllerMessageHandlerTest, PanTiltRelativePositionUseLivePosition)
+{
+    common::MessageQueue mq_;
+    PtzfStatusIf status;
+
+    // 現在位置はPanTiltPositionStatus通知から保持する
+    PanTiltPositionStatus position_msg(U32_T(0), U32_T(0), U32_T(0));
+    handler_->handleRequest(position_msg);
+
+    SetPanTiltRelativePositionRequest biz_msg_2way;
+    biz_msg_2way.seq_id = U32_T(123456);
+    biz_msg_2way.mq_name = mq_.getName();
+    biz_msg_2way.pan_speed = U8_T(0x01);
+    biz_msg_2way.tilt_speed = U8_T(0x01);
+
+    EXPECT_CALL(ptzf_status_infra_if_mock_, getPanTiltPosition(_, _, _)).Times(0);
+    ARRAY_FOREACH (pan_rel_values, i) {
+        biz_msg_2way.seq_id = i + 1;
+        biz_msg_2way.pan_position = pan_rel_values[i];
+        biz_msg_2way.tilt_position = tilt_rel_values[i];
+        EXPECT_CALL(pan_tilt_infra_if_mock_,
+                    movePanTiltRelative(Eq(biz_msg_2way.pan_speed),
+                                        Eq(biz_msg_2way.tilt_speed),
+                                        Eq(status.panSinDataToViscaData(biz_msg_2way.pan_position)),
+                                        Eq(status.tiltSinDataToViscaData(biz_msg_2way.tilt_position)),
+                                        _,
+                                        Eq(biz_msg_2way.seq_id)))
+            .Times(1)
+            .WillOnce(Return());
+        handler_->handleRequest(biz_msg_2way);
+    }
+}
+
 TEST_F(PtzfControllerMessageHandlerTest, PanTiltRelativeMoveSuccess)
 {
     // ### for Biz(1Way) ### //
@@ -5863,7 +5921,7 @@ TEST_F(PtzfControllerMessageHandlerTest, receiveUnlockToLockEventWithPowerOn)
 {
     // PowerON中 Unlock --> Lock処理
     // (step1: Finalize処理開始)
-    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(2).WillRepeatedly(Return(power::PowerStatus::POWER_ON));
+    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(1).WillOnce(Return(power::PowerStatus::POWER_ON));
     EXPECT_CALL(ptzf_status_infra_if_mock_, getPanTiltLockControlStatus(_))
         .Times(1)
         .WillOnce(DoAll(SetArgReferee<0>(PAN_TILT_LOCK_STATUS_UNLOCKED), Return(true)));
@@ -5898,6 +5956,7 @@ TEST_F(PtzfControllerMessageHandlerTest, receiveUnlockToLockEventWithPowerOn)
 
     FinalizePanTiltResult comp_message(seq_id, ERRORCODE_SUCCESS);
     handler_->handleRequest(comp_message);
+    completePanTiltLockOperations(U32_T(2));
 
     // (step3: PT電源断処理完了 & 制御状態更新)
     EXPECT_CALL(ptzf_status_infra_if_mock_, setPanTiltLockControlStatus(Eq(PAN_TILT_LOCK_STATUS_LOCKED)))
@@ -5912,10 +5971,11 @@ TEST_F(PtzfControllerMessageHandlerTest, receiveUnlockToLockEventWithPowerOn)
     EXPECT_CALL(pan_tilt_lock_infra_if_mock_, getPanTiltLock(_))
         .Times(1)
         .WillOnce(DoAll(SetArgReferee<0>(true), Return(ERRORCODE_SUCCESS)));
-    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(1).WillOnce(Return(power::PowerStatus::POWER_ON));
+    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(0);
 
     visca::CompReply visca_reply(ERRORCODE_SUCCESS, seq_id_2);
     handler_->handleRequest(visca_reply);
+    completePanTiltLockOperations(U32_T(2));
 }
 
 TEST_F(PtzfControllerMessageHandlerTest, receiveUnlockToLockEventWithPowerOnInitializing)
@@ -5923,6 +5983,9 @@ TEST_F(PtzfControllerMessageHandlerTest, receiveUnlockToLockEventWithPowerOnInit
     // PowerON中 Unlock --> Lock処理
     // * Initialize中のため, Finalizeせずに処理終了する
     EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(1).WillOnce(Return(power::PowerStatus::POWER_ON));
+    EXPECT_CALL(ptzf_status_infra_if_mock_, getPowerOnSequenceStatus(_))
+        .Times(1)
+        .WillOnce(DoAll(SetArgReferee<0>(true), Return(true)));
     EXPECT_CALL(sequence_id_controller_mock_, createSeqId()).Times(0);
     EXPECT_CALL(finalize_infra_if_mock_, finalizePanTilt(_, _)).Times(0);
 
@@ -5939,7 +6002,7 @@ TEST_F(PtzfControllerMessageHandlerTest, receiveUnlockToLockEventWithPowerOnInit
 TEST_F(PtzfControllerMessageHandlerTest, receiveUnlockToLockEventWithPowerOff)
 {
     // PowerOFF中 Unlock --> Lock処理 (制御状態更新のみ)
-    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(3).WillRepeatedly(Return(power::PowerStatus::POWER_OFF));
+    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(1).WillOnce(Return(power::PowerStatus::POWER_OFF));
     EXPECT_CALL(sequence_id_controller_mock_, createSeqId()).Times(0);
     EXPECT_CALL(finalize_infra_if_mock_, finalizePanTilt(_, _)).Times(0);
 
@@ -5980,10 +6043,129 @@ TEST_F(PtzfControllerMessageHandlerTest, receiveUnlockToLockEventWithPowerProces
     handler_->handleRequest(event_message);
 }
 
+TEST_F(PtzfControllerMessageHandlerTest, receiveUnlockToLockEventRereadProcessingPowerStatus)
+{
+    // 起動処理中の電源状態は保持せず, イベント受信ごとに読み出す
+    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(3).WillRepeatedly(Return(power::PowerStatus::PROCESSING_ON));
+    EXPECT_CALL(sequence_id_controller_mock_, createSeqId()).Times(0);
+    EXPECT_CALL(finalize_infra_if_mock_, finalizePanTilt(_, _)).Times(0);
+    EXPECT_CALL(ptzf_status_infra_if_mock_, setPanTiltLockControlStatus(_)).Times(0);
+
+    infra::PanTiltLockStatusChangedEvent event_message(false, true);
+    handler_->handleRequest(event_message);
+    handler_->handleRequest(event_message);
+    handler_->handleRequest(event_message);
+}
+
+TEST_F(PtzfControllerMessageHandlerTest, receiveUnlockToLockEventAfterPowerOnFailure)
+{
+    EXPECT_CALL(pan_tilt_lock_infra_if_mock_, suppressLockStatusEvent(false, _))
+        .Times(1)
+        .WillRepeatedly(testing::Invoke([](testing::Unused, const common::MessageQueueName& reply_name) {
+            common::MessageQueue local_mq(reply_name.name);
+            ptzf::message::PtzfExecComp result;
+            local_mq.post(result);
+        }));
+    EXPECT_CALL(initialize_infra_if_mock_, setPowerOnSequenceStatus(false, _))
+        .Times(1)
+        .WillRepeatedly(testing::Invoke([](testing::Unused, const common::MessageQueueName& reply_name) {
+            common::MessageQueue local_mq(reply_name.name);
+            ptzf::message::PtzfExecComp result;
+            local_mq.post(result);
+            return true;
+        }));
+
+    PowerOnResult msg;
+    msg.result_power_on = false;
+    handler_->handleRequest(msg);
+
+    // 起動に失敗した場合もPOWER_ONとはみなさず, 電源管理側の状態で判定する
+    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(1).WillOnce(Return(power::PowerStatus::PROCESSING_ON));
+    EXPECT_CALL(sequence_id_controller_mock_, createSeqId()).Times(0);
+    EXPECT_CALL(finalize_infra_if_mock_, finalizePanTilt(_, _)).Times(0);
+    EXPECT_CALL(ptzf_status_infra_if_mock_, setPanTiltLockControlStatus(_)).Times(0);
+
+    infra::PanTiltLockStatusChangedEvent event_message(false, true);
+    handler_->handleRequest(event_message);
+}
+
+TEST_F(PtzfControllerMessageHandlerTest, receiveUnlockToLockEventDuringPanTiltReset)
+{
+    PanTiltResetRequest reset_msg;
+    reset_msg.seq_id = U32_T(1);
+    reset_msg.mode_checked = true;
+    reset_msg.need_ack = false;
+    EXPECT_CALL(pan_tilt_lock_infra_if_mock_, getPanTiltLock(_))
+        .Times(1)
+        .WillOnce(DoAll(SetArgReferee<0>(false), Return(ERRORCODE_SUCCESS)));
+    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(2).WillRepeatedly(Return(power::PowerStatus::POWER_ON));
+    EXPECT_CALL(controller_mock_, resetPanTiltPosition(_, false, _)).Times(1).WillOnce(Return());
+    handler_->handleRequest(reset_msg);
+
+    // PanTiltReset中のInitializeはPtzfController側でシーケンス状態を設定するため, イベント受信ごとに読み出す
+    EXPECT_CALL(ptzf_status_infra_if_mock_, getPowerOnSequenceStatus(_))
+        .Times(2)
+        .WillRepeatedly(DoAll(SetArgReferee<0>(true), Return(true)));
+    EXPECT_CALL(ptzf_status_infra_if_mock_, getPowerOffSequenceStatus(_))
+        .Times(2)
+        .WillRepeatedly(DoAll(SetArgReferee<0>(false), Return(true)));
+    EXPECT_CALL(sequence_id_controller_mock_, createSeqId()).Times(0);
+    EXPECT_CALL(finalize_infra_if_mock_, finalizePanTilt(_, _)).Times(0);
+    EXPECT_CALL(ptzf_status_infra_if_mock_, setPanTiltLockControlStatus(_)).Times(0);
+
+    infra::PanTiltLockStatusChangedEvent event_message(false, true);
+    handler_->handleRequest(event_message);
+    handler_->handleRequest(event_message);
+
+    ResetPanTiltCompReply reply(ERRORCODE_SUCCESS);
+    handler_->handleRequest(reply);
+}
+
+TEST_F(PtzfControllerMessageHandlerTest, receiveUnlockToLockEventDuringPanTiltResetAfterLoaded)
+{
+    // シーケンス状態を読み出して保持する (Lock制御状態はロック済みのため遷移しない)
+    // PanTiltReset開始後のPowerOnSequenceStatusはPtzfController側でtrueに設定される
+    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(2).WillRepeatedly(Return(power::PowerStatus::POWER_ON));
+    EXPECT_CALL(ptzf_status_infra_if_mock_, getPowerOnSequenceStatus(_))
+        .Times(3)
+        .WillOnce(DoAll(SetArgReferee<0>(false), Return(true)))
+        .WillRepeatedly(DoAll(SetArgReferee<0>(true), Return(true)));
+    EXPECT_CALL(ptzf_status_infra_if_mock_, getPowerOffSequenceStatus(_))
+        .Times(3)
+        .WillRepeatedly(DoAll(SetArgReferee<0>(false), Return(true)));
+    EXPECT_CALL(ptzf_status_infra_if_mock_, getPanTiltLockControlStatus(_))
+        .Times(1)
+        .WillOnce(DoAll(SetArgReferee<0>(PAN_TILT_LOCK_STATUS_LOCKED), Return(true)));
+    EXPECT_CALL(pan_tilt_lock_infra_if_mock_, getPanTiltLock(_))
+        .Times(2)
+        .WillOnce(DoAll(SetArgReferee<0>(true), Return(ERRORCODE_SUCCESS)))
+        .WillOnce(DoAll(SetArgReferee<0>(false), Return(ERRORCODE_SUCCESS)));
+    EXPECT_CALL(controller_mock_, resetPanTiltPosition(_, false, _)).Times(1).WillOnce(Return());
+    EXPECT_CALL(sequence_id_controller_mock_, createSeqId()).Times(0);
+    EXPECT_CALL(finalize_infra_if_mock_, finalizePanTilt(_, _)).Times(0);
+    EXPECT_CALL(ptzf_status_infra_if_mock_, setPanTiltLockControlStatus(_)).Times(0);
+
+    infra::PanTiltLockStatusChangedEvent event_message(false, true);
+    handler_->handleRequest(event_message);
+
+    PanTiltResetRequest reset_msg;
+    reset_msg.seq_id = U32_T(1);
+    reset_msg.mode_checked = true;
+    reset_msg.need_ack = false;
+    handler_->handleRequest(reset_msg);
+
+    // * PanTiltReset中は保持していたシーケンス状態を使わず, イベント受信ごとに読み出すこと
+    handler_->handleRequest(event_message);
+    handler_->handleRequest(event_message);
+
+    ResetPanTiltCompReply reply(ERRORCODE_SUCCESS);
+    handler_->handleRequest(reply);
+}
+
 TEST_F(PtzfControllerMessageHandlerTest, receiveLockToUnlockEventWithPowerOn)
 {
     // PowerON中 Lock --> Unlock処理
-    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(2).WillRepeatedly(Return(power::PowerStatus::POWER_ON));
+    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(1).WillOnce(Return(power::PowerStatus::POWER_ON));
     EXPECT_CALL(ptzf_status_infra_if_mock_, getPanTiltLockControlStatus(_))
         .Times(1)
         .WillOnce(DoAll(SetArgReferee<0>(PAN_TILT_LOCK_STATUS_LOCKED), Return(true)));
@@ -6008,6 +6190,7 @@ TEST_F(PtzfControllerMessageHandlerTest, receiveLockToUnlockEventWithPowerOn)
 
     infra::PanTiltLockStatusChangedEvent event_message(true, false);
     handler_->handleRequest(event_message);
+    completePanTiltLockOperations(U32_T(2));
 
     // (step2: PT電源供給処理完了 & 制御状態更新)
     // * 通電アンロックに遷移することを確認
@@ -6023,16 +6206,17 @@ TEST_F(PtzfControllerMessageHandlerTest, receiveLockToUnlockEventWithPowerOn)
     EXPECT_CALL(pan_tilt_lock_infra_if_mock_, getPanTiltLock(_))
         .Times(2)
         .WillRepeatedly(DoAll(SetArgReferee<0>(false), Return(ERRORCODE_SUCCESS)));
-    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(1).WillOnce(Return(power::PowerStatus::POWER_ON));
+    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(0);
 
     visca::CompReply visca_reply(ERRORCODE_SUCCESS, seq_id);
     handler_->handleRequest(visca_reply);
+    completePanTiltLockOperations(U32_T(2));
 }
 
 TEST_F(PtzfControllerMessageHandlerTest, receiveLockToUnlockEventWithPowerOnCancel1)
 {
     // PowerON中 Lock --> Unlock処理
-    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(3).WillRepeatedly(Return(power::PowerStatus::POWER_ON));
+    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(1).WillOnce(Return(power::PowerStatus::POWER_ON));
     EXPECT_CALL(sequence_id_controller_mock_, createSeqId()).Times(0);
     EXPECT_CALL(visca_if_mock_, sendPowerOnPanTiltRequest(_, _)).Times(0);
 
@@ -6062,7 +6246,7 @@ TEST_F(PtzfControllerMessageHandlerTest, receiveLockToUnlockEventWithPowerOnCanc
 TEST_F(PtzfControllerMessageHandlerTest, receiveLockToUnlockEventWithPowerOnCancel2)
 {
     // PowerON中 Lock --> Unlock処理
-    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(2).WillRepeatedly(Return(power::PowerStatus::POWER_ON));
+    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(1).WillOnce(Return(power::PowerStatus::POWER_ON));
     EXPECT_CALL(ptzf_status_infra_if_mock_, getPanTiltLockControlStatus(_))
         .Times(1)
         .WillOnce(DoAll(SetArgReferee<0>(PAN_TILT_LOCK_STATUS_LOCKED), Return(true)));
@@ -6095,17 +6279,28 @@ TEST_F(PtzfControllerMessageHandlerTest, receiveLockToUnlockEventWithPowerOnCanc
 
     infra::PanTiltLockStatusChangedEvent event_message(true, false);
     handler_->handleRequest(event_message);
+    completePanTiltLockOperations(U32_T(2));
 
     // (step2: PT電源供給処理完了 & 制御状態更新)
     // * このタイミングで中断判定 --> 電源断処理に移行
-    EXPECT_CALL(initialize_infra_if_mock_, setPowerOnSequenceStatus(Eq(false), _)).Times(1).WillOnce(Return(true));
-    EXPECT_CALL(finalize_infra_if_mock_, setPowerOffSequenceStatus(Eq(true), _)).Times(1).WillOnce(Return(true));
+    // * Initialize処理終了はPT電源断要求の後に行うこと
+    Sequence seq;
+    EXPECT_CALL(finalize_infra_if_mock_, setPowerOffSequenceStatus(Eq(true), _))
+        .Times(1)
+        .InSequence(seq)
+        .WillOnce(Return(true));
     EXPECT_CALL(visca_if_mock_, sendPowerOffPanTiltRequest(EqNotifyMqName(expected_mq.getName()), Eq(seq_id_2)))
         .Times(1)
+        .InSequence(seq)
         .WillOnce(Return());
+    EXPECT_CALL(initialize_infra_if_mock_, setPowerOnSequenceStatus(Eq(false), _))
+        .Times(1)
+        .InSequence(seq)
+        .WillOnce(Return(true));
 
     visca::CompReply visca_reply(ERRORCODE_SUCCESS, seq_id);
     handler_->handleRequest(visca_reply);
+    completePanTiltLockOperations(U32_T(3));
 
     // (step3: PT電源断処理完了 & 制御状態更新)
     // * 中断したのでLOCKEDに戻ることを確認
@@ -6121,10 +6316,11 @@ TEST_F(PtzfControllerMessageHandlerTest, receiveLockToUnlockEventWithPowerOnCanc
     EXPECT_CALL(pan_tilt_lock_infra_if_mock_, getPanTiltLock(_))
         .Times(1)
         .WillOnce(DoAll(SetArgReferee<0>(true), Return(ERRORCODE_SUCCESS)));
-    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(1).WillOnce(Return(power::PowerStatus::POWER_ON));
+    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(0);
 
     visca::CompReply visca_reply_2(ERRORCODE_SUCCESS, seq_id_2);
     handler_->handleRequest(visca_reply_2);
+    completePanTiltLockOperations(U32_T(2));
 }
 
 TEST_F(PtzfControllerMessageHandlerTest, receiveLockToUnlockEventWithPowerOnFinalizing)
@@ -6132,6 +6328,9 @@ TEST_F(PtzfControllerMessageHandlerTest, receiveLockToUnlockEventWithPowerOnFina
     // PowerON中 Lcok --> Unlock処理
     // * Finalize中のため, Initializeせずに処理終了する
     EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(1).WillOnce(Return(power::PowerStatus::POWER_ON));
+    EXPECT_CALL(ptzf_status_infra_if_mock_, getPowerOffSequenceStatus(_))
+        .Times(1)
+        .WillOnce(DoAll(SetArgReferee<0>(true), Return(true)));
     EXPECT_CALL(sequence_id_controller_mock_, createSeqId()).Times(0);
     EXPECT_CALL(visca_if_mock_, sendPowerOnPanTiltRequest(_, _)).Times(0);
 
@@ -6149,7 +6348,7 @@ TEST_F(PtzfControllerMessageHandlerTest, receiveLockToUnlockEventWithPowerOnFina
 TEST_F(PtzfControllerMessageHandlerTest, receiveLockToUnlockEventWithPowerOff)
 {
     // PowerOFF中 Lcok --> Unlock処理
-    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(3).WillRepeatedly(Return(power::PowerStatus::POWER_OFF));
+    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(1).WillOnce(Return(power::PowerStatus::POWER_OFF));
     EXPECT_CALL(sequence_id_controller_mock_, createSeqId()).Times(0);
     EXPECT_CALL(visca_if_mock_, sendPowerOnPanTiltRequest(_, _)).Times(0);
     EXPECT_CALL(pan_tilt_lock_infra_if_mock_, getPanTiltLock(_))
@@ -6194,7 +6393,7 @@ TEST_F(PtzfControllerMessageHandlerTest, receiveLockToUnlockEventWithPowerProces
 TEST_F(PtzfControllerMessageHandlerTest, receiveLockToUnlockFollowingUnlockToLock)
 {
     // PowerON中 Lock --> Unlock処理
-    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(2).WillRepeatedly(Return(power::PowerStatus::POWER_ON));
+    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(1).WillOnce(Return(power::PowerStatus::POWER_ON));
     EXPECT_CALL(ptzf_status_infra_if_mock_, getPanTiltLockControlStatus(_))
         .Times(1)
         .WillOnce(DoAll(SetArgReferee<0>(PAN_TILT_LOCK_STATUS_LOCKED), Return(true)));
@@ -6223,6 +6422,7 @@ TEST_F(PtzfControllerMessageHandlerTest, receiveLockToUnlockFollowingUnlockToLoc
 
     const infra::PanTiltLockStatusChangedEvent event_message(true, false);
     handler_->handleRequest(event_message);
+    completePanTiltLockOperations(U32_T(2));
 
     // (Initialize-step2: PT電源供給処理完了 & 制御状態更新)
     // * 通電アンロックに遷移することを確認
@@ -6239,7 +6439,7 @@ TEST_F(PtzfControllerMessageHandlerTest, receiveLockToUnlockFollowingUnlockToLoc
         .Times(2)
         .WillOnce(DoAll(SetArgReferee<0>(false), Return(ERRORCODE_SUCCESS)))
         .WillOnce(DoAll(SetArgReferee<0>(true), Return(ERRORCODE_SUCCESS))); // この時点でLock状態になっていることを検出
-    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(1).WillOnce(Return(power::PowerStatus::POWER_ON));
+    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(0);
 
     // (Finalize-step1: Finalize処理開始)
     // * 再度ロック状態に遷移するための処理が実行されることを確認
@@ -6249,6 +6449,7 @@ TEST_F(PtzfControllerMessageHandlerTest, receiveLockToUnlockFollowingUnlockToLoc
 
     const visca::CompReply visca_reply_initialize(ERRORCODE_SUCCESS, seq_id_list[0]);
     handler_->handleRequest(visca_reply_initialize);
+    completePanTiltLockOperations(U32_T(2));
 
     // (Finalize-step2: Finalize処理完了 & PT電源断処理開始)
     EXPECT_CALL(finalize_infra_if_mock_, setPowerOffSequenceStatus(Eq(true), _)).Times(1).WillOnce(Return(true));
@@ -6259,6 +6460,7 @@ TEST_F(PtzfControllerMessageHandlerTest, receiveLockToUnlockFollowingUnlockToLoc
 
     const FinalizePanTiltResult comp_message_finalize(seq_id_list[1], ERRORCODE_SUCCESS);
     handler_->handleRequest(comp_message_finalize);
+    completePanTiltLockOperations(U32_T(2));
 
     // (Finalize-step3: PT電源断処理完了 & 制御状態更新)
     EXPECT_CALL(ptzf_status_infra_if_mock_, setPanTiltLockControlStatus(Eq(PAN_TILT_LOCK_STATUS_LOCKED)))
@@ -6273,17 +6475,18 @@ TEST_F(PtzfControllerMessageHandlerTest, receiveLockToUnlockFollowingUnlockToLoc
     EXPECT_CALL(pan_tilt_lock_infra_if_mock_, getPanTiltLock(_))
         .Times(1)
         .WillOnce(DoAll(SetArgReferee<0>(true), Return(ERRORCODE_SUCCESS)));
-    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(1).WillOnce(Return(power::PowerStatus::POWER_ON));
+    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(0);
 
     const visca::CompReply visca_reply_finalize(ERRORCODE_SUCCESS, seq_id_list[2]);
     handler_->handleRequest(visca_reply_finalize);
+    completePanTiltLockOperations(U32_T(2));
 }
 
 TEST_F(PtzfControllerMessageHandlerTest, receiveUnlockToLockFollowingLockToUnlock)
 {
     // PowerON中 Unlock --> Lock処理
     // (step1: Finalize処理開始)
-    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(2).WillRepeatedly(Return(power::PowerStatus::POWER_ON));
+    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(1).WillOnce(Return(power::PowerStatus::POWER_ON));
     EXPECT_CALL(ptzf_status_infra_if_mock_, getPanTiltLockControlStatus(_))
         .Times(1)
         .WillOnce(DoAll(SetArgReferee<0>(PAN_TILT_LOCK_STATUS_UNLOCKED), Return(true)));
@@ -6318,6 +6521,7 @@ TEST_F(PtzfControllerMessageHandlerTest, receiveUnlockToLockFollowingLockToUnloc
 
     const FinalizePanTiltResult comp_message_finalize(seq_id_list[0], ERRORCODE_SUCCESS);
     handler_->handleRequest(comp_message_finalize);
+    completePanTiltLockOperations(U32_T(2));
 
     // (step3: PT電源断処理完了 & 制御状態更新)
     EXPECT_CALL(ptzf_status_infra_if_mock_, setPanTiltLockControlStatus(Eq(PAN_TILT_LOCK_STATUS_LOCKED)))
@@ -6334,7 +6538,7 @@ TEST_F(PtzfControllerMessageHandlerTest, receiveUnlockToLockFollowingLockToUnloc
         .WillOnce(
             DoAll(SetArgReferee<0>(false), Return(ERRORCODE_SUCCESS))) // この時点でUnlock状態になっていることを検出
         .WillOnce(DoAll(SetArgReferee<0>(false), Return(ERRORCODE_SUCCESS)));
-    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(1).WillOnce(Return(power::PowerStatus::POWER_ON));
+    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(0);
 
     // (step1: PT電源供給処理開始)
     EXPECT_CALL(initialize_infra_if_mock_, setPowerOnSequenceStatus(Eq(true), _)).Times(1).WillOnce(Return(true));
@@ -6345,6 +6549,7 @@ TEST_F(PtzfControllerMessageHandlerTest, receiveUnlockToLockFollowingLockToUnloc
 
     const visca::CompReply visca_reply_finalize(ERRORCODE_SUCCESS, seq_id_list[1]);
     handler_->handleRequest(visca_reply_finalize);
+    completePanTiltLockOperations(U32_T(4));
 
     // (step2: PT電源供給処理完了 & 制御状態更新)
     // * 通電アンロックに遷移することを確認
@@ -6360,10 +6565,458 @@ TEST_F(PtzfControllerMessageHandlerTest, receiveUnlockToLockFollowingLockToUnloc
     EXPECT_CALL(pan_tilt_lock_infra_if_mock_, getPanTiltLock(_))
         .Times(2)
         .WillRepeatedly(DoAll(SetArgReferee<0>(false), Return(ERRORCODE_SUCCESS)));
-    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(1).WillOnce(Return(power::PowerStatus::POWER_ON));
+    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(0);
 
     const visca::CompReply visca_reply_initialize(ERRORCODE_SUCCESS, seq_id_list[2]);
     handler_->handleRequest(visca_reply_initialize);
+    completePanTiltLockOperations(U32_T(2));
+}
+
+TEST_F(PtzfControllerMessageHandlerTest, receiveMoveRequestDuringLockToUnlock)
+{
+    // PowerON中 Lock --> Unlock処理
+    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(1).WillOnce(Return(power::PowerStatus::POWER_ON));
+    EXPECT_CALL(ptzf_status_infra_if_mock_, getPanTiltLockControlStatus(_))
+        .Times(1)
+        .WillOnce(DoAll(SetArgReferee<0>(PAN_TILT_LOCK_STATUS_LOCKED), Return(true)));
+    u32_t seq_id = U32_T(123);
+    EXPECT_CALL(sequence_id_controller_mock_, createSeqId()).Times(1).WillOnce(Return(seq_id));
+    EXPECT_CALL(pan_tilt_lock_infra_if_mock_, getPanTiltLock(_))
+        .Times(2)
+        .WillRepeatedly(DoAll(SetArgReferee<0>(false), Return(ERRORCODE_SUCCESS)));
+
+    // * 操作の完了通知を受けるまで, PT電源供給は要求されないこと
+    // * その間に受信した移動リクエストは先に処理されること
+    // * PT電源供給の完了通知を受けるまでの間に受信した移動リクエストも, 遷移処理の完了を待たずに処理されること
+    Sequence seq;
+    const u32_t move_count = U32_T(ARRAY_LENGTH(pan_rel_values));
+    EXPECT_CALL(initialize_infra_if_mock_, setPowerOnSequenceStatus(Eq(true), _))
+        .Times(1)
+        .InSequence(seq)
+        .WillOnce(Return(true));
+    EXPECT_CALL(pan_tilt_infra_if_mock_, movePanTiltRelative(_, _, _, _, _, _))
+        .Times(move_count)
+        .InSequence(seq)
+        .WillRepeatedly(Return());
+    EXPECT_CALL(pan_tilt_lock_infra_if_mock_, suppressLockStatusEvent(Eq(true), _))
+        .Times(1)
+        .InSequence(seq)
+        .WillOnce(Return());
+    const char_t* expected_name = PtzfControllerMQ::getUipcName();
+    common::MessageQueue expected_mq(expected_name);
+    EXPECT_CALL(visca_if_mock_, sendPowerOnPanTiltRequest(EqNotifyMqName(expected_mq.getName()), Eq(seq_id)))
+        .Times(1)
+        .InSequence(seq)
+        .WillOnce(Return());
+    EXPECT_CALL(pan_tilt_infra_if_mock_, movePanTiltRelative(_, _, _, _, _, _))
+        .Times(move_count)
+        .InSequence(seq)
+        .WillRepeatedly(Return());
+    EXPECT_CALL(ptzf_status_infra_if_mock_,
+                setPanTiltLockControlStatus(Eq(PAN_TILT_LOCK_STATUS_UNLOCKED_AFTER_BOOTING)))
+        .Times(1)
+        .InSequence(seq)
+        .WillOnce(Return(true));
+    EXPECT_CALL(pan_tilt_lock_infra_if_mock_, suppressLockStatusEvent(Eq(false), _))
+        .Times(1)
+        .InSequence(seq)
+        .WillOnce(Return());
+    EXPECT_CALL(initialize_infra_if_mock_, setPowerOnSequenceStatus(Eq(false), _))
+        .Times(1)
+        .InSequence(seq)
+        .WillOnce(Return(true));
+
+    infra::PanTiltLockStatusChangedEvent event_message(true, false);
+    handler_->handleRequest(event_message);
+
+    common::MessageQueue mq_;
+    SetPanTiltRelativePositionRequest biz_msg_2way;
+    biz_msg_2way.mq_name = mq_.getName();
+    biz_msg_2way.pan_speed = U8_T(0x01);
+    biz_msg_2way.tilt_speed = U8_T(0x01);
+    ARRAY_FOREACH (pan_rel_values, i) {
+        biz_msg_2way.seq_id = i + 1;
+        biz_msg_2way.pan_position = pan_rel_values[i];
+        biz_msg_2way.tilt_position = tilt_rel_values[i];
+        handler_->handleRequest(biz_msg_2way);
+        // 遷移処理中に再度通知されたイベントは処理しないこと
+        handler_->handleRequest(event_message);
+    }
+
+    completePanTiltLockOperations(U32_T(2));
+
+    // PT電源供給の完了待ち
+    ARRAY_FOREACH (pan_rel_values, i) {
+        biz_msg_2way.seq_id = move_count + i + 1;
+        biz_msg_2way.pan_position = pan_rel_values[i];
+        biz_msg_2way.tilt_position = tilt_rel_values[i];
+        handler_->handleRequest(biz_msg_2way);
+        handler_->handleRequest(event_message);
+    }
+
+    // PT電源供給処理完了 & 制御状態更新
+    EXPECT_CALL(ptzf_status_infra_if_mock_, getPanTiltLockControlStatus(_))
+        .Times(1)
+        .WillOnce(DoAll(SetArgReferee<0>(PAN_TILT_LOCK_STATUS_UNLOCKED_AFTER_BOOTING), Return(true)));
+    EXPECT_CALL(pan_tilt_lock_infra_if_mock_, getPanTiltLock(_))
+        .Times(2)
+        .WillRepeatedly(DoAll(SetArgReferee<0>(false), Return(ERRORCODE_SUCCESS)));
+
+    visca::CompReply visca_reply(ERRORCODE_SUCCESS, seq_id);
+    handler_->handleRequest(visca_reply);
+    completePanTiltLockOperations(U32_T(2));
+}
+
+TEST_F(PtzfControllerMessageHandlerTest, receiveLockToUnlockEventTransitionTimeout)
+{
+    // PowerON中 Lock --> Unlock処理 (step1: PT電源供給処理開始)
+    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(1).WillOnce(Return(power::PowerStatus::POWER_ON));
+    EXPECT_CALL(ptzf_status_infra_if_mock_, getPanTiltLockControlStatus(_))
+        .Times(1)
+        .WillOnce(DoAll(SetArgReferee<0>(PAN_TILT_LOCK_STATUS_LOCKED), Return(true)));
+    u32_t seq_id = U32_T(123);
+    EXPECT_CALL(sequence_id_controller_mock_, createSeqId()).Times(1).WillOnce(Return(seq_id));
+    EXPECT_CALL(pan_tilt_lock_infra_if_mock_, getPanTiltLock(_))
+        .Times(2)
+        .WillRepeatedly(DoAll(SetArgReferee<0>(false), Return(ERRORCODE_SUCCESS)));
+    EXPECT_CALL(initialize_infra_if_mock_, setPowerOnSequenceStatus(Eq(true), _)).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(pan_tilt_lock_infra_if_mock_, suppressLockStatusEvent(Eq(true), _)).Times(1).WillOnce(Return());
+    const char_t* expected_name = PtzfControllerMQ::getUipcName();
+    common::MessageQueue expected_mq(expected_name);
+    EXPECT_CALL(visca_if_mock_, sendPowerOnPanTiltRequest(EqNotifyMqName(expected_mq.getName()), Eq(seq_id)))
+        .Times(1)
+        .WillOnce(Return());
+
+    infra::PtzfStatusInfraIf status_infra_if;
+    status_infra_if.setPowerOnSequenceStatus(false);
+    status_infra_if.setPowerOffSequenceStatus(false);
+
+    infra::PanTiltLockStatusChangedEvent event_message(true, false);
+    handler_->handleRequest(event_message);
+    completePanTiltLockOperations(U32_T(2));
+
+    // PT電源供給の完了通知が返らないまま期限切れ
+    // * シーケンス状態とイベント抑止を解除した後, 現在のLock状態で再判定すること
+    EXPECT_CALL(initialize_infra_if_mock_, setPowerOnSequenceStatus(Eq(false), _)).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(finalize_infra_if_mock_, setPowerOffSequenceStatus(Eq(false), _)).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(pan_tilt_lock_infra_if_mock_, suppressLockStatusEvent(Eq(false), _)).Times(1).WillOnce(Return());
+    EXPECT_CALL(ptzf_status_infra_if_mock_, getPanTiltLockControlStatus(_))
+        .Times(1)
+        .WillOnce(DoAll(SetArgReferee<0>(PAN_TILT_LOCK_STATUS_LOCKED), Return(true)));
+    EXPECT_CALL(pan_tilt_lock_infra_if_mock_, getPanTiltLock(_))
+        .Times(1)
+        .WillOnce(DoAll(SetArgReferee<0>(true), Return(ERRORCODE_SUCCESS)));
+    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(0);
+
+    PanTiltLockTransitionTimeout timeout_message;
+    handler_->handleRequest(timeout_message);
+    completePanTiltLockOperations(U32_T(3));
+
+    // * 期限切れ後に返ったPT電源供給の完了通知ではLock制御状態を更新しないこと
+    // * 遷移処理の完了後に期限切れを受信しても何もしないこと
+    EXPECT_CALL(ptzf_status_infra_if_mock_, setPanTiltLockControlStatus(_)).Times(0);
+    EXPECT_CALL(initialize_infra_if_mock_, setPowerOnSequenceStatus(_, _)).Times(0);
+    EXPECT_CALL(finalize_infra_if_mock_, setPowerOffSequenceStatus(_, _)).Times(0);
+    EXPECT_CALL(pan_tilt_lock_infra_if_mock_, suppressLockStatusEvent(_, _)).Times(0);
+
+    visca::CompReply visca_reply(ERRORCODE_SUCCESS, seq_id);
+    handler_->handleRequest(visca_reply);
+    handler_->handleRequest(timeout_message);
+}
+
+TEST_F(PtzfControllerMessageHandlerTest, receiveLockToUnlockEventLateReplyAfterTimeoutWithMoveRequest)
+{
+    // PowerON中 Lock --> Unlock処理 (step1: PT電源供給処理開始)
+    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(1).WillOnce(Return(power::PowerStatus::POWER_ON));
+    EXPECT_CALL(ptzf_status_infra_if_mock_, getPanTiltLockControlStatus(_))
+        .Times(1)
+        .WillOnce(DoAll(SetArgReferee<0>(PAN_TILT_LOCK_STATUS_LOCKED), Return(true)));
+    u32_t seq_id = U32_T(123);
+    EXPECT_CALL(sequence_id_controller_mock_, createSeqId()).Times(1).WillOnce(Return(seq_id));
+    EXPECT_CALL(pan_tilt_lock_infra_if_mock_, getPanTiltLock(_))
+        .Times(2)
+        .WillRepeatedly(DoAll(SetArgReferee<0>(false), Return(ERRORCODE_SUCCESS)));
+    EXPECT_CALL(initialize_infra_if_mock_, setPowerOnSequenceStatus(Eq(true), _)).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(pan_tilt_lock_infra_if_mock_, suppressLockStatusEvent(Eq(true), _)).Times(1).WillOnce(Return());
+    EXPECT_CALL(visca_if_mock_, sendPowerOnPanTiltRequest(_, Eq(seq_id))).Times(1).WillOnce(Return());
+
+    infra::PtzfStatusInfraIf status_infra_if;
+    status_infra_if.setPowerOnSequenceStatus(false);
+    status_infra_if.setPowerOffSequenceStatus(false);
+
+    infra::PanTiltLockStatusChangedEvent event_message(true, false);
+    handler_->handleRequest(event_message);
+    completePanTiltLockOperations(U32_T(2));
+
+    // PT電源供給の完了通知が返らないまま期限切れ
+    EXPECT_CALL(initialize_infra_if_mock_, setPowerOnSequenceStatus(Eq(false), _)).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(finalize_infra_if_mock_, setPowerOffSequenceStatus(Eq(false), _)).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(pan_tilt_lock_infra_if_mock_, suppressLockStatusEvent(Eq(false), _)).Times(1).WillOnce(Return());
+    EXPECT_CALL(ptzf_status_infra_if_mock_, getPanTiltLockControlStatus(_))
+        .Times(1)
+        .WillOnce(DoAll(SetArgReferee<0>(PAN_TILT_LOCK_STATUS_LOCKED), Return(true)));
+    EXPECT_CALL(pan_tilt_lock_infra_if_mock_, getPanTiltLock(_))
+        .Times(1)
+        .WillOnce(DoAll(SetArgReferee<0>(true), Return(ERRORCODE_SUCCESS)));
+
+    PanTiltLockTransitionTimeout timeout_message;
+    handler_->handleRequest(timeout_message);
+    completePanTiltLockOperations(U32_T(3));
+
+    // 期限切れ後に移動リクエストを受け付ける
+    EXPECT_CALL(pan_tilt_infra_if_mock_, movePanTiltRelative(_, _, _, _, _, _)).Times(1).WillOnce(Return());
+    common::MessageQueue move_reply_mq;
+    SetPanTiltRelativePositionRequest move_msg;
+    move_msg.mq_name = move_reply_mq.getName();
+    move_msg.seq_id = U32_T(1);
+    move_msg.pan_speed = U8_T(0x01);
+    move_msg.tilt_speed = U8_T(0x01);
+    move_msg.pan_position = pan_rel_values[0];
+    move_msg.tilt_position = tilt_rel_values[0];
+    handler_->handleRequest(move_msg);
+
+    // * 期限切れ前に要求したPT電源供給の完了通知は, 移動リクエストの完了として返さずに破棄すること
+    EXPECT_CALL(ptzf_status_infra_if_mock_, setPanTiltLockControlStatus(_)).Times(0);
+    visca::CompReply visca_reply(ERRORCODE_SUCCESS, seq_id);
+    handler_->handleRequest(visca_reply);
+
+    common::MessageQueueAttribute attr;
+    move_reply_mq.getAttribute(attr);
+    EXPECT_EQ(0, attr.message_size_current);
+    move_reply_mq.unlink();
+}
+
+TEST_F(PtzfControllerMessageHandlerTest, receiveLockToUnlockEventTransitionTimeoutWithOperationInFlight)
+{
+    // PowerON中 Lock --> Unlock処理 (step1: PT電源供給処理開始)
+    // * Initialize処理中への変更が完了待ちのまま期限切れ
+    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(1).WillOnce(Return(power::PowerStatus::POWER_ON));
+    EXPECT_CALL(ptzf_status_infra_if_mock_, getPanTiltLockControlStatus(_))
+        .Times(1)
+        .WillOnce(DoAll(SetArgReferee<0>(PAN_TILT_LOCK_STATUS_LOCKED), Return(true)));
+    EXPECT_CALL(pan_tilt_lock_infra_if_mock_, getPanTiltLock(_))
+        .Times(2)
+        .WillRepeatedly(DoAll(SetArgReferee<0>(false), Return(ERRORCODE_SUCCESS)));
+    EXPECT_CALL(initialize_infra_if_mock_, setPowerOnSequenceStatus(Eq(true), _)).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(sequence_id_controller_mock_, createSeqId()).Times(0);
+    EXPECT_CALL(visca_if_mock_, sendPowerOnPanTiltRequest(_, _)).Times(0);
+
+    infra::PtzfStatusInfraIf status_infra_if;
+    status_infra_if.setPowerOnSequenceStatus(false);
+    status_infra_if.setPowerOffSequenceStatus(false);
+
+    infra::PanTiltLockStatusChangedEvent event_message(true, false);
+    handler_->handleRequest(event_message);
+
+    // * 完了待ちの操作の完了通知を受けるまで, 解除の操作を要求しないこと
+    EXPECT_CALL(initialize_infra_if_mock_, setPowerOnSequenceStatus(Eq(false), _)).Times(0);
+    EXPECT_CALL(finalize_infra_if_mock_, setPowerOffSequenceStatus(_, _)).Times(0);
+    EXPECT_CALL(pan_tilt_lock_infra_if_mock_, suppressLockStatusEvent(_, _)).Times(0);
+
+    PanTiltLockTransitionTimeout timeout_message;
+    handler_->handleRequest(timeout_message);
+
+    // * 中断前の操作の完了通知を受けたら, イベント抑止を要求せずに解除の操作を順に要求すること
+    Sequence seq;
+    EXPECT_CALL(initialize_infra_if_mock_, setPowerOnSequenceStatus(Eq(false), _))
+        .Times(1)
+        .InSequence(seq)
+        .WillOnce(Return(true));
+    EXPECT_CALL(finalize_infra_if_mock_, setPowerOffSequenceStatus(Eq(false), _))
+        .Times(1)
+        .InSequence(seq)
+        .WillOnce(Return(true));
+    EXPECT_CALL(pan_tilt_lock_infra_if_mock_, suppressLockStatusEvent(Eq(false), _))
+        .Times(1)
+        .InSequence(seq)
+        .WillOnce(Return());
+    EXPECT_CALL(ptzf_status_infra_if_mock_, getPanTiltLockControlStatus(_))
+        .Times(1)
+        .InSequence(seq)
+        .WillOnce(DoAll(SetArgReferee<0>(PAN_TILT_LOCK_STATUS_LOCKED), Return(true)));
+    EXPECT_CALL(pan_tilt_lock_infra_if_mock_, getPanTiltLock(_))
+        .Times(1)
+        .InSequence(seq)
+        .WillOnce(DoAll(SetArgReferee<0>(true), Return(ERRORCODE_SUCCESS)));
+    EXPECT_CALL(pan_tilt_lock_infra_if_mock_, suppressLockStatusEvent(Eq(true), _)).Times(0);
+    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(0);
+
+    completePanTiltLockOperations(U32_T(4));
+
+    // * 要求していない完了通知は無視すること
+    completePanTiltLockOperations(U32_T(1));
+}
+
+TEST_F(PtzfControllerMessageHandlerTest, receivePowerOffDuringUnlockToLockDone)
+{
+    // PowerON中 Unlock --> Lock処理 (step1: Finalize処理開始)
+    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(1).WillOnce(Return(power::PowerStatus::POWER_ON));
+    EXPECT_CALL(ptzf_status_infra_if_mock_, getPanTiltLockControlStatus(_))
+        .Times(1)
+        .WillOnce(DoAll(SetArgReferee<0>(PAN_TILT_LOCK_STATUS_UNLOCKED), Return(true)));
+    EXPECT_CALL(pan_tilt_lock_infra_if_mock_, getPanTiltLock(_))
+        .Times(1)
+        .WillOnce(DoAll(SetArgReferee<0>(true), Return(ERRORCODE_SUCCESS)));
+    u32_t seq_id = U32_T(123);
+    u32_t seq_id_2 = U32_T(234);
+    EXPECT_CALL(sequence_id_controller_mock_, createSeqId())
+        .Times(2)
+        .WillOnce(Return(seq_id))
+        .WillOnce(Return(seq_id_2));
+    const char_t* expected_name = PtzfControllerMQ::getUipcName();
+    common::MessageQueue expected_mq(expected_name);
+    EXPECT_CALL(finalize_infra_if_mock_, finalizePanTilt(EqNotifyMqName(expected_mq.getName()), Eq(seq_id)))
+        .Times(1)
+        .WillOnce(Return(true));
+
+    infra::PtzfStatusInfraIf status_infra_if;
+    status_infra_if.setPowerOnSequenceStatus(false);
+    status_infra_if.setPowerOffSequenceStatus(false);
+
+    infra::PanTiltLockStatusChangedEvent event_message(false, true);
+    handler_->handleRequest(event_message);
+
+    // (step2: Finalize処理完了 & PT電源断処理開始)
+    EXPECT_CALL(finalize_infra_if_mock_, setPowerOffSequenceStatus(Eq(true), _)).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(pan_tilt_lock_infra_if_mock_, suppressLockStatusEvent(Eq(true), _)).Times(1).WillOnce(Return());
+    EXPECT_CALL(visca_if_mock_, sendPowerOffPanTiltRequest(EqNotifyMqName(expected_mq.getName()), Eq(seq_id_2)))
+        .Times(1)
+        .WillOnce(Return());
+
+    FinalizePanTiltResult comp_message(seq_id, ERRORCODE_SUCCESS);
+    handler_->handleRequest(comp_message);
+    completePanTiltLockOperations(U32_T(2));
+
+    // (step3: PT電源断処理完了 & 制御状態更新)
+    // * イベント抑止の解除が完了待ちのまま, PowerOFF処理中フラグのOFFは未実行
+    EXPECT_CALL(ptzf_status_infra_if_mock_, setPanTiltLockControlStatus(Eq(PAN_TILT_LOCK_STATUS_LOCKED)))
+        .Times(1)
+        .WillOnce(Return(true));
+    EXPECT_CALL(initialize_infra_if_mock_, setPanTiltFunctionLimitForCamera(Eq(true))).Times(1).WillOnce(Return());
+    EXPECT_CALL(pan_tilt_lock_infra_if_mock_, suppressLockStatusEvent(Eq(false), _)).Times(1).WillOnce(Return());
+    EXPECT_CALL(finalize_infra_if_mock_, setPowerOffSequenceStatus(Eq(false), _)).Times(0);
+
+    visca::CompReply visca_reply(ERRORCODE_SUCCESS, seq_id_2);
+    handler_->handleRequest(visca_reply);
+
+    // PowerOff受信
+    // * 遷移処理で設定済みのPowerOFF処理中フラグは, PowerOffの設定より前に解除すること
+    // * イベント抑止の解除は完了待ちの操作として要求済みのため, 再要求しないこと
+    Sequence seq;
+    EXPECT_CALL(finalize_infra_if_mock_, setPowerOffSequenceStatus(Eq(false), _))
+        .Times(1)
+        .InSequence(seq)
+        .WillOnce(Return(true));
+    EXPECT_CALL(finalize_infra_if_mock_, setPowerOffSequenceStatus(Eq(true), _))
+        .Times(1)
+        .InSequence(seq)
+        .WillOnce(Return(true));
+    EXPECT_CALL(pan_tilt_lock_infra_if_mock_, suppressLockStatusEvent(Eq(true), _))
+        .Times(1)
+        .InSequence(seq)
+        .WillOnce(Return());
+    EXPECT_CALL(ptzf_status_infra_if_mock_, getPanTiltLockControlStatus(_))
+        .Times(1)
+        .WillOnce(DoAll(SetArgReferee<0>(PAN_TILT_LOCK_STATUS_LOCKED), Return(true)));
+    EXPECT_CALL(visca_if_mock_, sendPowerOffPanTiltRequest()).Times(0);
+    EXPECT_CALL(ptzf_message_if_mock_, noticePowerOffResult(Eq(true))).Times(1).WillOnce(Return());
+
+    PowerOff power_off_message;
+    handler_->handleRequest(power_off_message);
+
+    // * 完了待ちだった操作の完了通知を受けても, 遷移処理の残りの操作を要求しないこと
+    EXPECT_CALL(finalize_infra_if_mock_, setPowerOffSequenceStatus(Eq(false), _)).Times(0);
+    EXPECT_CALL(pan_tilt_lock_infra_if_mock_, suppressLockStatusEvent(_, _)).Times(0);
+    EXPECT_CALL(ptzf_status_infra_if_mock_, getPanTiltLockControlStatus(_)).Times(0);
+    EXPECT_CALL(pan_tilt_lock_infra_if_mock_, getPanTiltLock(_)).Times(0);
+
+    completePanTiltLockOperations(U32_T(2));
+
+    // * 取り消し後の期限切れは無視すること
+    PanTiltLockTransitionTimeout timeout_message;
+    handler_->handleRequest(timeout_message);
+}
+
+TEST_F(PtzfControllerMessageHandlerTest, receiveLockEventAfterPowerOffDuringLockToUnlock)
+{
+    // PowerON中 Lock --> Unlock処理 (step1: PT電源供給処理開始)
+    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(1).WillOnce(Return(power::PowerStatus::POWER_ON));
+    EXPECT_CALL(ptzf_status_infra_if_mock_, getPanTiltLockControlStatus(_))
+        .Times(1)
+        .WillOnce(DoAll(SetArgReferee<0>(PAN_TILT_LOCK_STATUS_LOCKED), Return(true)));
+    u32_t seq_id = U32_T(123);
+    EXPECT_CALL(sequence_id_controller_mock_, createSeqId()).Times(1).WillOnce(Return(seq_id));
+    EXPECT_CALL(pan_tilt_lock_infra_if_mock_, getPanTiltLock(_))
+        .Times(2)
+        .WillRepeatedly(DoAll(SetArgReferee<0>(false), Return(ERRORCODE_SUCCESS)));
+
+    infra::PtzfStatusInfraIf status_infra_if;
+    status_infra_if.setPowerOnSequenceStatus(false);
+    status_infra_if.setPowerOffSequenceStatus(false);
+
+    EXPECT_CALL(initialize_infra_if_mock_, setPowerOnSequenceStatus(Eq(true), _)).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(pan_tilt_lock_infra_if_mock_, suppressLockStatusEvent(Eq(true), _)).Times(1).WillOnce(Return());
+    EXPECT_CALL(visca_if_mock_, sendPowerOnPanTiltRequest(_, Eq(seq_id))).Times(1).WillOnce(Return());
+
+    infra::PanTiltLockStatusChangedEvent event_message(true, false);
+    handler_->handleRequest(event_message);
+    completePanTiltLockOperations(U32_T(2));
+
+    // PowerOff受信 (PT電源供給処理の完了待ち)
+    // * 遷移処理で設定したPowerON処理中フラグとイベント抑止を, PowerOffの設定より前に解除すること
+    Sequence seq;
+    EXPECT_CALL(initialize_infra_if_mock_, setPowerOnSequenceStatus(Eq(false), _))
+        .Times(1)
+        .InSequence(seq)
+        .WillOnce(Return(true));
+    EXPECT_CALL(pan_tilt_lock_infra_if_mock_, suppressLockStatusEvent(Eq(false), _))
+        .Times(1)
+        .InSequence(seq)
+        .WillOnce(Return());
+    EXPECT_CALL(finalize_infra_if_mock_, setPowerOffSequenceStatus(Eq(true), _))
+        .Times(1)
+        .InSequence(seq)
+        .WillOnce(Return(true));
+    EXPECT_CALL(pan_tilt_lock_infra_if_mock_, suppressLockStatusEvent(Eq(true), _))
+        .Times(1)
+        .InSequence(seq)
+        .WillOnce(Return());
+    EXPECT_CALL(ptzf_status_infra_if_mock_, getPanTiltLockControlStatus(_))
+        .Times(1)
+        .WillOnce(DoAll(SetArgReferee<0>(PAN_TILT_LOCK_STATUS_LOCKED), Return(true)));
+    EXPECT_CALL(visca_if_mock_, sendPowerOffPanTiltRequest()).Times(0);
+    EXPECT_CALL(ptzf_message_if_mock_, noticePowerOffResult(Eq(true))).Times(1).WillOnce(Return());
+
+    PowerOff power_off_message;
+    handler_->handleRequest(power_off_message);
+
+    // PowerOffResult受信
+    EXPECT_CALL(er_mock_, post(_, _, _, _)).Times(1).WillOnce(Return());
+    EXPECT_CALL(ptzf_status_infra_if_mock_, getPanTiltLockControlStatus(_))
+        .Times(1)
+        .WillOnce(DoAll(SetArgReferee<0>(PAN_TILT_LOCK_STATUS_LOCKED), Return(true)));
+    EXPECT_CALL(pan_tilt_lock_infra_if_mock_, suppressLockStatusEvent(Eq(false), _)).Times(1).WillOnce(Return());
+    EXPECT_CALL(finalize_infra_if_mock_, setPowerOffSequenceStatus(Eq(false), _)).Times(1).WillOnce(Return(true));
+
+    PowerOffResult power_off_result;
+    power_off_result.result_power_off = true;
+    handler_->handleRequest(power_off_result);
+
+    // PowerOFF中 Lock --> Unlock処理
+    // * PowerON処理中フラグが残っていないため, Initialize実行中として捨てずに遷移処理を行うこと
+    EXPECT_CALL(power_status_if_mock_, getPowerStatus()).Times(1).WillOnce(Return(power::PowerStatus::POWER_OFF));
+    EXPECT_CALL(pan_tilt_lock_infra_if_mock_, getPanTiltLock(_))
+        .Times(3)
+        .WillRepeatedly(DoAll(SetArgReferee<0>(false), Return(ERRORCODE_SUCCESS)));
+    EXPECT_CALL(ptzf_status_infra_if_mock_, getPanTiltLockControlStatus(_))
+        .Times(2)
+        .WillOnce(DoAll(SetArgReferee<0>(PAN_TILT_LOCK_STATUS_LOCKED), Return(true)))
+        .WillOnce(DoAll(SetArgReferee<0>(PAN_TILT_LOCK_STATUS_UNLOCKED), Return(true)));
+    EXPECT_CALL(ptzf_status_infra_if_mock_, setPanTiltLockControlStatus(Eq(PAN_TILT_LOCK_STATUS_UNLOCKED)))
+        .Times(1)
+        .WillOnce(Return(true));
+
+    handler_->handleRequest(event_message);
 }
 
 TEST_F(PtzfControllerMessageHandlerTest, FocusModeValue)